@@ -51,27 +51,27 @@ void Card::play(int index,int airLift, Player* player,Player* otherPlayer, Terri
 
 	//Temporary pointer to the card played
 	Card* playedCard = player->getHand()->getCardInHand(index);
-	cout << "\nThe " << playedCard->cardTypeName << " card has been played." << '\n';
+	NARRATE(gameEngine) << "\nThe " << playedCard->cardTypeName << " card has been played." << '\n';
 	//Creates a pointer to an order of the card's type
 	//Order* order = new Order(hand->getCardInHand(index)->getCardTypeName());
 	switch (enumToInt(playedCard->getCardTypeName())) {
 	case 0:
-		player->getOrdersList()->addOrders(new Bomb(player,target, gameEngine));
+		player->getOrdersList()->addOrders(gameEngine->getOrderArena().create<Bomb>(player,target, gameEngine));
 		break;
 	case 1:
-        cout << "Reinforcement card played immediately" << endl;
-        cout << "Old reinforcement pool army count : " << player->getReinforcementPool() << endl;
+        NARRATE(gameEngine) << "Reinforcement card played immediately" << endl;
+        NARRATE(gameEngine) << "Old reinforcement pool army count : " << player->getReinforcementPool() << endl;
         player->setReinforcementPool(player->getReinforcementPool()+ 5);
-        cout << "New reinforcement pool army count : " << player->getReinforcementPool() << endl;
+        NARRATE(gameEngine) << "New reinforcement pool army count : " << player->getReinforcementPool() << endl;
 		break;
 	case 2:
-        player->getOrdersList()->addOrders(new Blockade(player,target,gameEngine));
+        player->getOrdersList()->addOrders(gameEngine->getOrderArena().create<Blockade>(player,target,gameEngine));
 		break;
 	case 3:
-        player->getOrdersList()->addOrders(new Airlift(player, airLift, start, target, gameEngine));
+        player->getOrdersList()->addOrders(gameEngine->getOrderArena().create<Airlift>(player, airLift, start, target, gameEngine));
 		break;
 	case 4:
-        player->getOrdersList()->addOrders(new Negotiate(player,otherPlayer, gameEngine));
+        player->getOrdersList()->addOrders(gameEngine->getOrderArena().create<Negotiate>(player,otherPlayer, gameEngine));
 		break;
 	}
 
@@ -133,7 +133,10 @@ Deck::Deck() : sizeDeck(5) {
 }
 
 //Constructor accepting an integer
-Deck::Deck(int number) : sizeDeck(number) {
+Deck::Deck(int number) : Deck(number, nullptr) {}
+
+//Constructor accepting an integer and the random number generator used to pick the cards
+Deck::Deck(int number, Random* rng) : sizeDeck(number), rng(rng) {
 	int numberCorrected{ number - 5 };
 
 	//Making sure the deck has a card of each type
@@ -146,7 +149,7 @@ Deck::Deck(int number) : sizeDeck(number) {
 	for (int i = 0; i < numberCorrected; i++) {
 
 		//Random int from 0 to 4
-		int typeNumber{ rand() % 4 };
+		int typeNumber{ getRandom()->nextInt(4) };
 
 		switch (typeNumber) {
 		case 0:
@@ -170,7 +173,7 @@ Deck::Deck(int number) : sizeDeck(number) {
 }
 
 //Copy constructor
-Deck::Deck(const Deck& deck) : sizeDeck(deck.sizeDeck) {
+Deck::Deck(const Deck& deck) : sizeDeck(deck.sizeDeck), rng(deck.rng), output(deck.output) {
 	for (int i = 0; i < deck.cards.size(); i++) {
 		cards.push_back(deck.cards[i]);
 	}
@@ -180,6 +183,8 @@ Deck::Deck(const Deck& deck) : sizeDeck(deck.sizeDeck) {
 Deck& Deck::operator= (const Deck& deck) {
 	this->sizeDeck = deck.sizeDeck;
 	this->cards = deck.cards;
+	this->rng = deck.rng;
+	this->output = deck.output;
 
 	return *this;
 }
@@ -195,7 +200,7 @@ int Deck::getSize() {
 //Draw method that takes a card from the deck and adds it to the player's hand
 Card* Deck::draw() {
 	//Random int from 0 to the size of the deck
-	int index{ rand() % (int)cards.size() };
+	int index{ getRandom()->nextInt((int)cards.size()) };
 
 	//Temporary pointer to the drawn card
 	Card* cardDrawn = cards[index];
@@ -206,10 +211,40 @@ Card* Deck::draw() {
 	return cardDrawn;
 }
 
+void Deck::setRandom(Random* rng) {
+	this->rng = rng;
+}
+
+void Deck::setOutput(Output* output) {
+	this->output = output;
+}
+
+//Returns the deck's output, narrative output on cout if it does not belong to a game
+Output* Deck::getOutput() {
+	return output != nullptr ? output : &Output::standard();
+}
+
+//Returns the deck's random number generator. A deck that does not belong to a game uses one private to its thread.
+Random* Deck::getRandom() {
+	if (rng == nullptr) {
+		static thread_local Random threadRandom;
+		return &threadRandom;
+	}
+	return rng;
+}
+
 //Adds a card to the deck
 void Deck::addCard(Card* card) {
 	cards.push_back(card);
-	cout << "\nThe " << card->getCardTypeName() << " card has been added to the deck." << '\n';
+	GAME_OUTPUT(*getOutput(), Verbosity::Narrative) << "\nThe " << card->getCardTypeName() << " card has been added to the deck." << '\n';
+}
+
+const vector<Card*>& Deck::getCards() {
+	return cards;
+}
+
+void Deck::setCards(const vector<Card*>& cards) {
+	this->cards = cards;
 }
 
 //Destructor for the deck object
@@ -283,6 +318,10 @@ vector<Card*> Hand::getCardsInHand() {
 	return cardsInHand;
 }
 
+void Hand::setCardsInHand(const vector<Card*>& cards) {
+	cardsInHand = cards;
+}
+
 //Removes a card at a specified index from the hand
 void Hand::removeCard(int index) {
 	cardsInHand.erase(cardsInHand.begin() + index);
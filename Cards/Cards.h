@@ -7,6 +7,8 @@
 #include "../Orders/Orders.h"
 #include "../Map/Map.h"
 #include "../Game Engine/GameEngine.h"
+#include "../Game Engine/Random.h"
+#include "../Game Engine/Output.h"
 
 using namespace std;
 
@@ -42,12 +44,23 @@ class Deck {
 public:
 	Deck();
 	Deck(int);
+	Deck(int, Random*);
 	Deck(const Deck&);
 	Deck& operator= (const Deck&);
 	void setSize(int sizeDeck);
 	int getSize();
 	Card* draw();
 	void addCard(Card* card);
+	//Cards left in the deck, in drawing order
+	const vector<Card*>& getCards();
+	//Replaces the cards in the deck without writing any message (used to restore a snapshot)
+	void setCards(const vector<Card*>& cards);
+	//Random number generator used for drawing, normally the game's own
+	void setRandom(Random* rng);
+	Random* getRandom();
+	//Output the deck's messages are written to, normally the game's own
+	void setOutput(Output* output);
+	Output* getOutput();
 	~Deck();
 
 	friend ostream& operator<< (ostream&, const vector<Card*>);
@@ -58,6 +71,8 @@ public:
 private:
 	int sizeDeck{};
 	vector<Card*> cards;
+	Random* rng{ nullptr };
+	Output* output{ nullptr };
 };
 
 class Hand {
@@ -72,6 +87,8 @@ public:
 	void setMaxSize(int);
 	int getMaxSize();
 	vector<Card*> getCardsInHand();
+	//Replaces the cards in the hand (used to restore a snapshot)
+	void setCardsInHand(const vector<Card*>& cards);
 	//Change name of this
 	void removeCard(int);
 	bool handFull();
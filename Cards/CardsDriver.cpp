@@ -7,7 +7,6 @@
 using namespace std;
 
 int main() {
-	srand((int)time(NULL));					//Regenerate the seed for the rand() call
 
 	Card* card = new Card();				//Create an object card
 
@@ -57,6 +57,9 @@ Command::Command(commandType command, string toAdd, Observer* _obs) {
 // Copy constructor
 Command::Command(const Command& command) : commandstr(command.commandstr), effect(command.effect), toAdd(command.toAdd), commandNumber(command.commandNumber) { }
 
+// Destructor
+Command::~Command() { }
+
 // Overloading the assignment operator
 Command& Command::operator= (const Command& command) {
 	this->commandstr = command.commandstr;
@@ -127,6 +130,14 @@ string Command::stringToLog() {
 	return command;
 }
 
+// toLogRecord implementation for ILoggable
+bool Command::toLogRecord(LogRecord& record) {
+	record.event = LogEvent::CommandIssued;
+	record.text = getCommandStr();
+	record.detail = getEffect();
+	return true;
+}
+
 // Overloading the output operator
 ostream& operator<< (ostream& out, const Command& command) {
 	return out << "Command: " << command.commandstr << command.toAdd << " | Effect: " << command.effect << '\n';
@@ -326,6 +337,14 @@ string CommandProcessor::stringToLog()
 	return "Inserted command: " + commandList.back()->getCommandStr() + " into the list.";
 }
 
+// toLogRecord implementation for ILoggable
+bool CommandProcessor::toLogRecord(LogRecord& record)
+{
+	record.event = LogEvent::CommandInserted;
+	record.text = commandList.back()->getCommandStr();
+	return true;
+}
+
 // Overloading the output operator
 ostream& operator<< (ostream& out, const vector<Command*>& commandList) {
 	out << "\n[ ";
@@ -23,6 +23,7 @@ public:
 	Command(string, Observer*);
 	Command(commandType, string, Observer*);
 	Command(const Command& command);
+	virtual ~Command();
 	Command& operator= (const Command&);
 	void saveEffect(Command*);
 	string getCommandStr();
@@ -32,6 +33,8 @@ public:
 
 	// stringToLog Implementation for ILoggable
 	string stringToLog();
+	// toLogRecord Implementation for ILoggable
+	bool toLogRecord(LogRecord&);
 
 	friend ostream& operator<< (ostream&, const Command&);
 
@@ -52,7 +55,7 @@ public:
 	CommandProcessor(Observer*);
 	CommandProcessor(const CommandProcessor&);
 	CommandProcessor& operator= (const CommandProcessor&);
-	~CommandProcessor();
+	virtual ~CommandProcessor();
 	virtual Command* readCommand();
 	void getCommand(GameEngine*, CommandProcessor*);
 	void saveCommand(Command*);
@@ -67,6 +70,8 @@ public:
 
 	// stringToLog Implementation for ILoggable
 	string stringToLog();
+	// toLogRecord Implementation for ILoggable
+	bool toLogRecord(LogRecord&);
 
 	friend ostream& operator<< (ostream&, const vector<Command*>&);
 
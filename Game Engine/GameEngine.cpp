@@ -3,7 +3,10 @@
 #include "../Player/Player.h"
 #include <regex>
 #include <math.h>
-#include <random>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <cstring>
 // Members of State Class
 
 State::State() : stateName("none") {}
@@ -46,10 +49,14 @@ ostream& operator<<(ostream& out, const Transition& transition)
 // Members of GameEngine class
 
 GameEngine::GameEngine() : currentState(nullptr), deck(new Deck()), cmd_currentState(nullptr), map(nullptr) {
+    deck->setRandom(&rng);
+    deck->setOutput(&output);
     players.push_back(new Player("NEUTRAL",new Hand(),this));
 }
 GameEngine::GameEngine(Observer* _obs) : currentState(nullptr), deck(new Deck()), _observer(_obs), cmd_currentState(nullptr), map(nullptr) {
     this->Attach(_obs);
+    deck->setRandom(&rng);
+    deck->setOutput(&output);
     players.push_back(new Player("NEUTRAL",new Hand(),this));
 }
 
@@ -95,6 +102,8 @@ GameEngine::GameEngine(const GameEngine& gameEngine)
 	this->players = gameEngine.players;
 	this->map = new Map(*gameEngine.map);
 	this->deck = new Deck(*gameEngine.deck);
+	this->deck->setRandom(&rng);
+	this->deck->setOutput(&output);
 	this->Attach(gameEngine._observer);
 }
 
@@ -105,6 +114,8 @@ GameEngine& GameEngine::operator=(const GameEngine& gameEngine)
 	this->players = gameEngine.players;
 	this->map = new Map(*gameEngine.map);
 	this->deck = new Deck(*gameEngine.deck);
+	this->deck->setRandom(&rng);
+	this->deck->setOutput(&output);
 	this->Attach(gameEngine._observer);
 	return *this;
 }
@@ -136,6 +147,53 @@ Deck* GameEngine::getDeck()
 void GameEngine::setDeck(Deck* newDeck)
 {
 	deck = newDeck;
+	if (deck != nullptr) {
+		deck->setRandom(&rng);
+		deck->setOutput(&output);
+	}
+}
+
+Random* GameEngine::getRandom()
+{
+	return &rng;
+}
+
+Output& GameEngine::getOutput()
+{
+	return output;
+}
+
+OrderArena& GameEngine::getOrderArena()
+{
+	return orderArena;
+}
+
+void GameEngine::releaseOrders()
+{
+	for (Player* p : players) {
+		p->getOrdersList()->clear();
+	}
+	orderArena.reset();
+}
+
+void GameEngine::saveSnapshot(GameSnapshot& snapshot)
+{
+	snapshot.save(this);
+}
+
+bool GameEngine::restoreSnapshot(const GameSnapshot& snapshot)
+{
+	return snapshot.restore(this);
+}
+
+Output& outputOf(GameEngine* game)
+{
+	return game != nullptr ? game->getOutput() : Output::standard();
+}
+
+void GameEngine::setSeed(uint64_t seed)
+{
+	rng.setSeed(seed);
 }
 
 void GameEngine::addPlayer(Player* player)
@@ -155,7 +213,7 @@ bool GameEngine::checkState(string command)
 		if (cmd_currentState->stateName == transitions[i]->current->stateName && command == transitions[i]->command)
 		{
 			cmd_currentState = transitions[i]->next;
-			cout << *cmd_currentState;
+			NARRATE(this) << *cmd_currentState;
 			return true;
 		}
 		else if (cmd_currentState->stateName == "win" && command == "end") return true;
@@ -170,7 +228,7 @@ bool GameEngine::changeState(string command)
 		if (currentState->stateName == transitions[i]->current->stateName && command == transitions[i]->command)
 		{
 			currentState = transitions[i]->next;
-			cout << *currentState;
+			NARRATE(this) << *currentState;
 			Notify(this);
 			return true;
 		}
@@ -209,8 +267,8 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 	// Use the command list to get the commands, make sure to change states in between commands
 	for (Command* c : cp->getValidCommandList()) {
 		// Display the current state
-		cout << endl;
-		cout << "Current state: " << currentState->stateName << endl << endl;
+		NARRATE(this) << endl;
+		NARRATE(this) << "Current state: " << currentState->stateName << endl << endl;
 
 		string command = c->getCommandStr();
 
@@ -223,30 +281,44 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 			// We found a map file name from the commmand's effect!
 			if (std::regex_search(effect, match, extractionPattern)) {
 				string mapFileName = (string)match[1];
-				setMap(MapLoader::createMapfromFile(mapFileName));
+				string error;
+				setMap(MapLoader::createMapfromFile(mapFileName, error));
+				if (map == NULL) {
+					REPORT(this) << error << endl;
+				}
 				
 				// Transition to 'validatemap' state, Handle failure
 				if (!changeState("loadmap")) {
-					cout << "ERROR: Could not transition to 'loadmap' from current state " << currentState->stateName << endl;
+					REPORT(this) << "ERROR: Could not transition to 'loadmap' from current state " << currentState->stateName << endl;
 				}
 			}
 		}
 
 		// Do I have to check if we are in a valid state before executing the command?
 		else if (command == "validatemap") {
-			// Validate the map
-			map->validate();
+			// Validate the map (a map file that could not be loaded counts as invalid)
+			if (map != NULL) {
+				map->validate(output);
+			}
 
-			if (map->isValid()) {
+			if (map != NULL && map->isValid()) {
+				// Later games on this map load it from the compiled map cache, skipping parsing and validation
+				if (!MapLoader::saveCache(map)) {
+					NARRATE(this) << "Could not save the compiled map cache " << MapLoader::cacheFileName(map->getSourceFile()) << endl;
+				}
 				// Transition to 'addplayer' state, handle failure
 				if (!changeState("validatemap")) {
-					cout << "ERROR: Could not to transition to 'validatemap' from current state " << currentState->stateName << endl;
+					REPORT(this) << "ERROR: Could not to transition to 'validatemap' from current state " << currentState->stateName << endl;
 				}
 			}
 
 			else {
 				// Does the state go back to loadmap, or do we just fail and exit?
-				cout << "An invalid map has been loaded." << endl;
+				REPORT(this) << "An invalid map has been loaded." << endl;
+				// A tournament game is played on a worker thread, so it ends here, without a winner, rather than ending the program
+				if (tournamentMode) {
+					return;
+				}
 				exit(1);
 			}
 		}
@@ -286,6 +358,14 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 						addPlayer(p);
 					}
 
+					else if (match[1] == "MonteCarlo" || match[1] == "montecarlo" || match[1] == "MONTECARLO") {
+						// Create and add Monte Carlo player. Tournament games already run one per core, so its rollouts stay on the game's thread.
+						Player* p = nullptr;
+						p = new Player("MonteCarlo", new Hand, this, new MonteCarloPlayerStrategy(NULL, 2000, 0, 2, tournamentMode ? 1 : 0));
+						p->getPlayerStrategy()->setPlayer(p);
+						addPlayer(p);
+					}
+
 					else if (match[1] == "Neutral" || match[1] == "neutral" || match[1] == "NEUTRAL") {
 						// Create and add neutral player
 						Player* p = nullptr;
@@ -301,7 +381,7 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 						}
 
 						else {
-							cout << "Invalid player strategy passed to tournament commands: Human players cannot be added." << endl;
+							REPORT(this) << "Invalid player strategy passed to tournament commands: Human players cannot be added." << endl;
 							exit(1);
 						}
 					}
@@ -310,7 +390,7 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 
 			else {
 				// Let the user know that they cannot add anymore players
-				cout << "Limit of players in game has been reached, no new players may be added." << endl;
+				REPORT(this) << "Limit of players in game has been reached, no new players may be added." << endl;
 			}
 
 
@@ -319,20 +399,17 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 
 				// Check if state changed successfully, otherwise handle failure.
 				if (!changeState("addplayer")) {
-					cout << "ERROR: Could not transition to 'addplayer' from current state " << currentState->stateName << endl;
+					REPORT(this) << "ERROR: Could not transition to 'addplayer' from current state " << currentState->stateName << endl;
 				}
 			}
 
 			else {
 				// Let the user know that there needs to be more players for the game to start
-				cout << "There must be at least 2 players before the game can start." << endl;
+				REPORT(this) << "There must be at least 2 players before the game can start." << endl;
 			}
 		}
 
 		else if (command == "gamestart") {
-			// Initialize random seed
-			srand(time(NULL));
-
 			/* Gamestart command does the following:
 			*  a) Evenly pass out territories to players (remainder goes to the neutral player).
 
@@ -365,7 +442,7 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 
 					while (i < territoriesPerPlayer) {
 						// Generate the index of a random territory
-						int choose = rand() % map->getTerritories().size();
+						int choose = rng.nextInt(map->getTerritories().size());
 
 						// If it hasn't already been taken, then give it to the player.
 						if (!std::count(taken.begin(), taken.end(), choose)) {
@@ -379,22 +456,13 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 
 			// Assign unassigned territories to Neutral player (How to get neutral player?).
 			for (Territory* t : map->getTerritories()) {
-				bool owned = false;
-
-				for (Player* p : players) {
-					if (p->ownsTerritory(t)) {
-						owned = true;
-						break;
-					}
-				}
-
-				if (!owned) {
+				if (t->getOwner() == nullptr) {
 					getNeutralPlayer()->addOwnedTerritory(t);
 				}
 			}
 
 			// Determine the turn order randomly - Re-arrange the players in the vector
-			std::shuffle(players.begin(), players.end(), std::random_device()); // This is not total randomization, given 'n' players this will produce the same shuffle order of those 'n' players.
+			std::shuffle(players.begin(), players.end(), rng);
 
 			// Give each player 50 armies to begin with and let them draw 2 cards from the deck
 			for (Player* p : players) {
@@ -415,7 +483,7 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 
 			// Only start the main game loop if the appropriate state can be changed to.
 			if (!changeState("gamestart")) {
-				cout << "ERROR: Could not transition to 'gamestart' from current state " << currentState->stateName << endl;
+				REPORT(this) << "ERROR: Could not transition to 'gamestart' from current state " << currentState->stateName << endl;
 			}
 
 			else {
@@ -433,6 +501,8 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 			vector<string> playerStrats; // Player strategies that will be playing the games
 			int numGames = 0; // The number of games to play on each map
 			int maxRounds = 0; // The maximum number of rounds that can be played before the game ends in a draw 
+			uint64_t seed = Random::randomSeed(); // Seed of the first game, optional (-S) so a tournament can be replayed
+			Verbosity verbosity = Verbosity::Silent; // How much each game writes out, optional (-V), nothing by default
 
 			string effect = c->getEffect();
 
@@ -444,7 +514,7 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 
 			// If one or more of these headers are not found in the command, then it is improperly formatted, so we exit.
 			if (effect.find(mapHeader) == string::npos || effect.find(playerHeader) == string::npos || effect.find(gameHeader) == string::npos || effect.find(roundsHeader) == string::npos) {
-				cout << "Tournament command is not properly formatted." << endl;
+				REPORT(this) << "Tournament command is not properly formatted." << endl;
 				exit(1);
 			}
 
@@ -488,7 +558,7 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 					toCompare = string(fields);
 
 					if (stoi(toCompare) < 1 || stoi(toCompare) > 5) {
-						cout << "Invalid number of games: must be between 1 and 5." << endl;
+						REPORT(this) << "Invalid number of games: must be between 1 and 5." << endl;
 						exit(1);
 					}
 
@@ -505,12 +575,35 @@ void GameEngine::startupPhase(CommandProcessor* cp)
 					toCompare = string(fields);
 
 					if (stoi(toCompare) < 10 || stoi(toCompare) > 50) {
-						cout << "Invalid number of rounds: must be between 10 and 50." << endl;
+						REPORT(this) << "Invalid number of rounds: must be between 10 and 50." << endl;
 						exit(1);
 					}
 					maxRounds = stoi(toCompare);
 				}
 
+				if (toCompare == "-S") {
+					// Get the seed of the first game
+
+					fields = strtok(NULL, " ,");
+
+					if (fields == NULL || !isdigit(fields[0])) {
+						REPORT(this) << "Invalid seed: must be a non-negative integer." << endl;
+						exit(1);
+					}
+					seed = stoull(string(fields));
+				}
+
+				if (toCompare == "-V") {
+					// Get the verbosity of the games
+
+					fields = strtok(NULL, " ,");
+
+					if (fields == NULL || !Output::parseLevel(string(fields), verbosity)) {
+						REPORT(this) << "Invalid verbosity: must be silent, summary or narrative." << endl;
+						exit(1);
+					}
+				}
+
 				fields = strtok(NULL, " ,");
 
 			}
@@ -520,50 +613,20 @@ void GameEngine::startupPhase(CommandProcessor* cp)
             tournamentResult = "";
 
 			if (mapFiles.size() < 1 || mapFiles.size() > 5) {
-				cout << "Invalid number of maps: must be between 1 and 5." << endl;
+				REPORT(this) << "Invalid number of maps: must be between 1 and 5." << endl;
 				exit(1);
 			}
 
 			if (playerStrats.size() < 2 || playerStrats.size() > 4) {
-				cout << "Invalid number of player strategies: must be between 2 and 4." << endl;
+				REPORT(this) << "Invalid number of player strategies: must be between 2 and 4." << endl;
 				exit(1);
 			}
 
-			for (string mapFileName : mapFiles) {
-
-				for (int i = 0; i < numGames; i++) {
-					CommandProcessor* cp2 = new CommandProcessor(this->_observer);
-					// Populate the command list with the commands necessary to start a new game
-					// Order to properly start a game is: loadmap, validatemap, addplayer, gamestart
-
-					// 1) Add loadmap command
-					Command* loadmap = new Command(Command::commandType::loadmap, mapFileName, this->_observer);
-					loadmap->saveEffect(loadmap);
-					cp2->saveValidCommand(loadmap);
-
-					// 2) Add validatemap command
-					Command* validatemap = new Command(Command::commandType::validatemap, "", this->_observer);
-					validatemap->saveEffect(validatemap);
-					cp2->saveValidCommand(validatemap);
-
-					// 3) Add addplayer commands
-					for (string strategy : playerStrats) {
-						Command* addplayer = new Command(Command::commandType::addplayer, strategy, this->_observer);
-						addplayer->saveEffect(addplayer);
-						cp2->saveValidCommand(addplayer);
-					}
-
-					// 4) Add gamestart command
-					Command* gamestart = new Command(Command::commandType::gamestart, "", this->_observer);
-					gamestart->saveEffect(gamestart);
-					cp2->saveValidCommand(gamestart);
+			// Play every (map, game) pair on its own engine, spread over a pool of threads
+			int firstResult = results.size();
+			vector<string> gameResults = playTournamentGames(mapFiles, playerStrats, numGames, maxRounds, seed, verbosity);
+			results.insert(results.end(), gameResults.begin(), gameResults.end());
 
-					// 5) Start a new game
-					startupPhase(cp2);
-					delete cp2;
-					cp2 = NULL;
-				}
-			}
             //Storing results in logFile
             // Modifying Tournament Result after the games are done
             tournamentResult = "Tournament Mode: \nM: ";
@@ -576,47 +639,192 @@ void GameEngine::startupPhase(CommandProcessor* cp)
             }
             tournamentResult += "\nG: " + to_string(numGames);
             tournamentResult += "\nD: " + to_string(maxRounds);
+            tournamentResult += "\nS: " + to_string(seed);
 
             tournamentResult += "\n\nResults: \n\n";
 
-            int x = 0; //Used to navigate throughout vector containing all the winners
+            int x = firstResult; //Used to navigate throughout vector containing all the winners
             for(const string& mapFileName: mapFiles){
                 tournamentResult += "````````````````Map : " + mapFileName + "``````````````````` \n";
                 for(int i = 0;i < numGames;i++){
                     tournamentResult += "Game number " + to_string(i+1)  + " : \n";
                     tournamentResult += "Winner : " + results.at(x) + "\n";
+                    tournamentResult += "Seed : " + to_string(seed + (x - firstResult)) + "\n";
                     x++;
                 }
             }
             tournamentResult += "\nEND OF TOURNAMENT - THANK YOU FOR PLAYING!";
             Notify(this);
-            cout << "END OF TOURNAMENT - THANK YOU FOR PLAYING!" << endl;
+            if (_observer != nullptr) _observer->flush();
+            REPORT(this) << "END OF TOURNAMENT - THANK YOU FOR PLAYING!" << endl;
 		}
 	}
 }
 
 void GameEngine::resetContext() {
+	clearGame();
+	getNeutralPlayer();
+
+	// Reset Deck
+	delete this->deck;
+	this->deck = NULL;
+	this->deck = new Deck(52, &rng);
+	this->deck->setOutput(&output);
+
+	// Go back to start state
+	this->currentState = this->states.at(0);
+}
+
+// Deletes the map and the players of the current game
+void GameEngine::clearGame() {
 	// Clear map
 	if (this->map != NULL) {
 		delete this->map;
 		this->map = NULL;
 	}
 
-	// Clear players
+	// Clear players, and the orders they still had
+	releaseOrders();
 	for (int i = 0; i < this->players.size(); i++) {
 		delete this->players.at(i);
 		this->players.at(i) = NULL;
 	}
 	this->players.clear();
-	getNeutralPlayer();
+}
 
-	// Reset Deck
-	delete this->deck;
-	this->deck = NULL;
-	this->deck = new Deck(52);
+// Gives this engine its own copy of the states and transitions of another engine
+void GameEngine::copyRules(const GameEngine& gameEngine) {
+	vector<State*> copies;
 
-	// Go back to start state
-	this->currentState = this->states.at(0);
+	for (State* state : gameEngine.states) {
+		copies.push_back(newState(state->stateName));
+	}
+
+	for (Transition* transition : gameEngine.transitions) {
+		State* current = nullptr;
+		State* next = nullptr;
+
+		for (int i = 0; i < gameEngine.states.size(); i++) {
+			if (gameEngine.states.at(i) == transition->current) current = copies.at(i);
+			if (gameEngine.states.at(i) == transition->next) next = copies.at(i);
+		}
+
+		newTransition(current, next, transition->command);
+	}
+
+	if (!states.empty()) {
+		currentState = states.at(0);
+		cmd_currentState = states.at(0);
+	}
+}
+
+/* Plays a single tournament game on a fresh engine that shares nothing with this one except the rules and the observer,
+so that several games can be played at the same time. The game draws every random number from its own generator,
+started from the given seed, so the same seed always replays the same game. Returns the winner's name, or "DRAW". */
+string GameEngine::playTournamentGame(string mapFileName, vector<string> playerStrats, int maxRounds, uint64_t seed, Verbosity verbosity, int gameNumber) {
+	GameEngine* game = new GameEngine(this->_observer);
+	game->setSeed(seed);
+	game->getOutput().setLevel(verbosity);
+	game->copyRules(*this);
+	game->tournamentMode = true;
+	game->max_rounds = maxRounds;
+	game->gameNumber = gameNumber;
+
+	CommandProcessor* cp = new CommandProcessor(this->_observer);
+	// Populate the command list with the commands necessary to start a new game
+	// Order to properly start a game is: loadmap, validatemap, addplayer, gamestart
+
+	// 1) Add loadmap command
+	Command* loadmap = new Command(Command::commandType::loadmap, mapFileName, this->_observer);
+	loadmap->saveEffect(loadmap);
+	cp->saveValidCommand(loadmap);
+
+	// 2) Add validatemap command
+	Command* validatemap = new Command(Command::commandType::validatemap, "", this->_observer);
+	validatemap->saveEffect(validatemap);
+	cp->saveValidCommand(validatemap);
+
+	// 3) Add addplayer commands
+	for (string strategy : playerStrats) {
+		Command* addplayer = new Command(Command::commandType::addplayer, strategy, this->_observer);
+		addplayer->saveEffect(addplayer);
+		cp->saveValidCommand(addplayer);
+	}
+
+	// 4) Add gamestart command
+	Command* gamestart = new Command(Command::commandType::gamestart, "", this->_observer);
+	gamestart->saveEffect(gamestart);
+	cp->saveValidCommand(gamestart);
+
+	// 5) Play the game
+	game->startupPhase(cp);
+
+	string winner = game->results.empty() ? "N/A" : game->results.back();
+
+	for (Command* c : cp->getValidCommandList()) {
+		delete c;
+	}
+	delete cp;
+	game->clearGame();
+	delete game;
+
+	return winner;
+}
+
+/* Plays numGames games on each map. The games are independent, so they are handed out to a pool of threads (one per core):
+each thread keeps taking the next game that nobody has started until there are none left. Each result is stored at the
+game's own position, so the results come back in the same (map, game) order no matter which thread played which game.
+Game i is seeded with seed + i, whichever thread plays it.
+Every map is loaded and validated once, on the calling thread, before any game starts. The games of an invalid map are
+not played: their result is "INVALID MAP". */
+vector<string> GameEngine::playTournamentGames(vector<string> mapFiles, vector<string> playerStrats, int numGames, int maxRounds, uint64_t seed, Verbosity verbosity) {
+	int numTotalGames = mapFiles.size() * numGames;
+	vector<string> gameResults(numTotalGames);
+	atomic<int> nextGame(0);
+
+	// Only the reasons a map is invalid are written out
+	Output reasons(Verbosity::Summary, output.stream());
+	vector<bool> validMaps;
+	for (const string& mapFile : mapFiles) {
+		string error;
+		Map* m = MapLoader::createMapfromFile(mapFile, error);
+		if (m == NULL) {
+			REPORT(this) << error << endl;
+		}
+		else {
+			m->validate(reasons);
+		}
+		validMaps.push_back(m != NULL && m->isValid());
+		delete m;
+
+		if (!validMaps.back()) {
+			REPORT(this) << "An invalid map has been loaded: " << mapFile << ". Its games will not be played." << endl;
+		}
+	}
+
+	auto worker = [&]() {
+		for (int g = nextGame++; g < numTotalGames; g = nextGame++) {
+			if (!validMaps.at(g / numGames)) {
+				gameResults[g] = "INVALID MAP";
+				continue;
+			}
+			gameResults[g] = playTournamentGame(mapFiles.at(g / numGames), playerStrats, maxRounds, seed + g, verbosity, g + 1);
+		}
+	};
+
+	int numThreads = max(1, min((int)thread::hardware_concurrency(), numTotalGames));
+	vector<thread> pool;
+
+	for (int i = 1; i < numThreads; i++) {
+		pool.emplace_back(worker);
+	}
+	worker(); // The calling thread plays games too
+
+	for (thread& t : pool) {
+		t.join();
+	}
+
+	return gameResults;
 }
 
 // Main Game Loop
@@ -635,36 +843,62 @@ void GameEngine::mainGameLoop() {
 	// Keep track of how many rounds have passed
 	int roundsPassed = 0;
 
+	// Players to check for elimination or victory: everyone at first, then only those whose territory count has since dropped
+	// to 0 or reached every territory (see TerritoryState::takeOwnershipEvents)
+	vector<Player*> toCheck = players;
+
 	do {
 		if (roundsPassed >= this->max_rounds && this->max_rounds > 0) {
 			// The game should end in a draw.
-			cout << "Game has reached the maximum number of rounds... It's a draw. " << endl;
+			REPORT(this) << "Game has reached the maximum number of rounds... It's a draw. " << endl;
             //Storing the results in a vector
             results.push_back("DRAW");
+			// The game is over, make sure its log is written out
+			if (_observer != nullptr) _observer->flush();
 			break;
 		}
 
+		if (map != nullptr) {
+			map->getState()->takeOwnershipEvents(toCheck);
+		}
+		else {
+			toCheck = players;
+		}
+
+		// Players are checked in turn order, and eliminated players are only removed once every player has been checked
+		vector<Player*> eliminated;
 	    for (Player* p : players) {
+			if (toCheck.empty()) {
+				break;
+			}
+			if (find(toCheck.begin(), toCheck.end(), p) == toCheck.end()) {
+				continue;
+			}
+
+			// Territory counts are kept by the map's state on every change of owner
+			int numOwned = map != nullptr ? map->getState()->countOwnedBy(p) : (int)p->getOwnedTerritories().size();
 
 			// If player owns no territories, remove from game
-	        if (p->toDefend().empty() && p->getName() != "NEUTRAL") {
-				cout << "Player " << p->getName() << " has no more territories! Removing player " << p->getName() << " from the game!" << endl;
-				removePlayer(p);
+	        if (numOwned == 0 && p->getName() != "NEUTRAL") {
+				REPORT(this) << "Player " << p->getName() << " has no more territories! Removing player " << p->getName() << " from the game!" << endl;
+				eliminated.push_back(p);
 	        }
 
 			// If player owns all the territories, they win
-	        if (p->toDefend().size() >= numTotalTerritories) {
+	        if (numOwned >= numTotalTerritories) {
 
 				// Used to break the loop
 				onePlayerOwnsAllTerritories = true;
 
 				// Announce this player as winner
-				cout << "The winner is: " << p->getName() << "!" << endl;
+				REPORT(this) << "The winner is: " << p->getName() << "!" << endl;
 
                 //Storing the results in a vector
                 results.push_back(p->getName());
 				
 				changeState("win");
+				// The game is over, make sure its log is written out
+				if (_observer != nullptr) _observer->flush();
 
 				// In tournament mode, this doesnt hang for input from the user.
                 if(!tournamentMode){
@@ -680,6 +914,10 @@ void GameEngine::mainGameLoop() {
 				return;
 	        }
 	    }
+		toCheck.clear();
+		for (Player* p : eliminated) {
+			removePlayer(p);
+		}
 	
 		if (!onePlayerOwnsAllTerritories) {
 			// Reinforcement Phase
@@ -702,7 +940,7 @@ void GameEngine::mainGameLoop() {
 void GameEngine::reinforcementPhase() {
 	for (Player* p : players) {
 	    // Armies = # of territories owned divided by 3, rounded down : or 3 minimum
-	    int armies = floor(p->toDefend().size() / 3);
+	    int armies = map->getState()->countOwnedBy(p) / 3;
 	    // Bonus for owning all of a continent's territories gets added to the armies
 	    // Place armies in player's reinforcement pool
 		// Minimum 3 armies, or armies + continent bonus
@@ -720,36 +958,24 @@ void GameEngine::issueOrdersPhase() {
 }
 
 void GameEngine::executeOrdersPhase() {
-	for (Player* p : players) {
-        //Executing deploys first
-        if(p->getName()!="NEUTRAL"){
-            for(Orders* o: p->getOrdersList()->ordersList){
-                if(o->getName() == "Deploy"){
-                    o->execute();
-                    p->getOrdersList()->removeOrder(o);
-                }
-            }
-        }
-	}
-
-	// Find the longest list length
-	int longestList = 0;
+	vector<OrdersList*> lists;
 	for (Player* p : players) {
 		if (p->getName() != "NEUTRAL") {
-			if (p->getOrdersList()->ordersList.size() > longestList) {
-				longestList = p->getOrdersList()->ordersList.size();
-			}
+			p->getOrdersList()->queueForExecution();
+			lists.push_back(p->getOrdersList());
 		}
 	}
 
-	// Round-robin execution of the other orders
-	for (int i = 0; i < longestList; i++) {
-		for (Player* p : players) {
-			if (p->getName() != "NEUTRAL") {
-				if (!p->getOrdersList()->ordersList.empty()) {
-					Orders* o = p->getOrdersList()->ordersList.at(0);
-					o->execute();
-					p->getOrdersList()->removeOrder(o);
+	// Each priority class is drained before the next one starts (deploys, airlifts, blockades, then the rest), round-robin
+	// across the players: one order per player per pass until every lane of the class is exhausted
+	for (int priority = 0; priority < numOrderPriorities; priority++) {
+		bool executed = true;
+		while (executed) {
+			executed = false;
+			for (OrdersList* list : lists) {
+				if (const OrderData* o = list->next((OrderPriority)priority)) {
+					Orders::execute(*o, this);
+					executed = true;
 				}
 			}
 		}
@@ -759,6 +985,9 @@ void GameEngine::executeOrdersPhase() {
     for(auto it:players){
         it->receivedCardThisTurn = false;
     }
+
+	// Every order of the round has been executed, so their memory is reused by the next round
+	releaseOrders();
 }
 
 
@@ -771,6 +1000,33 @@ string GameEngine::stringToLog() {
     return "Current GameEngine State: " + currentState->stateName;
 }
 
+// toLogRecord Implementation for ILoggable
+bool GameEngine::toLogRecord(LogRecord& record) {
+    record.game = gameNumber;
+    if(!tournamentResult.empty()){
+        record.event = LogEvent::TournamentEnded;
+        record.text = tournamentResult;
+        return true;
+    }
+    record.event = LogEvent::StateChanged;
+    record.text = currentState->stateName;
+    return true;
+}
+
+void GameEngine::logOwnershipChange(Territory* territory, Player* from, Player* to) {
+    if(!isRecorded()){
+        return;
+    }
+    LogRecord record;
+    record.event = LogEvent::OwnershipChanged;
+    record.game = gameNumber;
+    record.player = to->getName();
+    if(from != nullptr) record.otherPlayer = from->getName();
+    record.target = territory->getName();
+    record.armies = territory->getNumberOfArmies();
+    Notify(record);
+}
+
 //Neutral Player related stuff for Blockade order in Orders.cpp
 
 Player* GameEngine::getNeutralPlayer(){
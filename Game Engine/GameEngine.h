@@ -8,11 +8,16 @@
 #include "../Map/Map.h"
 #include "../CommandProcessor/CommandProcessor.h"
 #include "../Cards/Cards.h"
+#include "Random.h"
+#include "Output.h"
+#include "Snapshot.h"
+#include "../Orders/OrderArena.h"
 using namespace std;
 
 // Forward declaration
 class Player;
 class Map;
+class Territory;
 class Deck;
 class CommandProcessor;
 class Observer;
@@ -79,6 +84,12 @@ public:
 	Deck* deck;
 	// Max number of rounds that can pass before game is declared a draw.
 	int max_rounds;
+	// This game's random number generator; every random choice in the game is drawn from it
+	Random rng;
+	// Where this game's messages are written, and how many of them
+	Output output;
+	// Where the orders of the current round are created; they are all reclaimed at the end of executeOrdersPhase()
+	OrderArena orderArena;
 	// Observer pointer
 	Observer* _observer = nullptr;
 
@@ -87,7 +98,7 @@ public:
 	// Observer pattern constructor
 	GameEngine(Observer* _obs);
 	// Destructor
-	~GameEngine();
+	virtual ~GameEngine();
 	// Copy constructor
 	GameEngine(const GameEngine& gameEngine);
 	// = assignment operator
@@ -102,6 +113,20 @@ public:
 	Deck* getDeck();
 	// Setter for deck
 	void setDeck(Deck*);
+	// Getter for the game's random number generator
+	Random* getRandom();
+	// Restart the game's random sequence from a seed, so a game can be replayed exactly
+	void setSeed(uint64_t seed);
+	// Getter for the game's output
+	Output& getOutput();
+	// Getter for the arena the game's orders are created in
+	OrderArena& getOrderArena();
+	// Drops every player's pending orders and reclaims the memory of all the orders created since the last call
+	void releaseOrders();
+	// Copies the state of the game into the snapshot (see GameSnapshot)
+	void saveSnapshot(GameSnapshot& snapshot);
+	// Puts the game back in the state the snapshot was taken in, false if the snapshot does not belong to this game's map
+	bool restoreSnapshot(const GameSnapshot& snapshot);
 	// Adds players to player list
 	void addPlayer(Player*);
 	// Remove a player from the player list
@@ -123,6 +148,18 @@ public:
 	// Reset GameEngine's context to start new games
 	void resetContext();
 
+	// Delete the current game's map and players
+	void clearGame();
+
+	// Give this engine its own copy of another engine's states and transitions
+	void copyRules(const GameEngine& gameEngine);
+
+	// Play one tournament game on a separate engine seeded with the given seed and return the winner ("DRAW" if there is none)
+	string playTournamentGame(string mapFileName, vector<string> playerStrats, int maxRounds, uint64_t seed, Verbosity verbosity, int gameNumber);
+
+	// Play every tournament game, in parallel, and return the winners in (map, game) order. Game i is seeded with seed + i.
+	vector<string> playTournamentGames(vector<string> mapFiles, vector<string> playerStrats, int numGames, int maxRounds, uint64_t seed, Verbosity verbosity);
+
 	// Main Game Loop
 	void mainGameLoop();
 
@@ -139,6 +176,10 @@ public:
 	//******************
 	// stringToLog Implementation for ILoggable
 	string stringToLog();
+	// toLogRecord Implementation for ILoggable
+	bool toLogRecord(LogRecord& record);
+	// Records that a territory changed hands, if the observer accepts records
+	void logOwnershipChange(Territory* territory, Player* from, Player* to);
 
     //checking for a neutral player among the list of players and if there isnt one , a pointer to one will be created
     //and added to the list of players
@@ -151,4 +192,15 @@ public:
     vector<string> results;
 
     string tournamentResult;
+
+    //Number of the game in the tournament (0 outside of tournaments), so the game each logged event belongs to is known
+    int gameNumber = 0;
 };
+
+// Output of the given game, or narrative output on cout if there is no game
+Output& outputOf(GameEngine* game);
+
+// Play-by-play message of a game, only built and written at the narrative level: NARRATE(game) << "..." << endl;
+#define NARRATE(game) GAME_OUTPUT(outputOf(game), Verbosity::Narrative)
+// Message that is still written at the summary level, such as errors and the outcome of a game
+#define REPORT(game) GAME_OUTPUT(outputOf(game), Verbosity::Summary)
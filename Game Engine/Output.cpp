@@ -0,0 +1,39 @@
+#include "Output.h"
+
+Output::Output() : level(Verbosity::Narrative), out(&cout) {}
+Output::Output(Verbosity level, ostream& stream) : level(level), out(&stream) {}
+
+void Output::setLevel(Verbosity level)
+{
+	this->level = level;
+}
+
+Verbosity Output::getLevel() const
+{
+	return level;
+}
+
+bool Output::enabled(Verbosity level) const
+{
+	return level != Verbosity::Silent && level <= this->level;
+}
+
+ostream& Output::stream()
+{
+	return *out;
+}
+
+Output& Output::standard()
+{
+	static Output output;
+	return output;
+}
+
+bool Output::parseLevel(string name, Verbosity& level)
+{
+	if (name == "silent") level = Verbosity::Silent;
+	else if (name == "summary") level = Verbosity::Summary;
+	else if (name == "narrative") level = Verbosity::Narrative;
+	else return false;
+	return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// How much of the game is written out, from nothing at all to the full play-by-play
+enum class Verbosity { Silent, Summary, Narrative };
+
+/* Destination of a game's console output. Messages are tagged with a verbosity level and only written if the output's
+level is at least that high. Write through GAME_OUTPUT so that a message that will not be shown is not even built. */
+class Output
+{
+public:
+	// Default constructor (narrative output on cout)
+	Output();
+	// Parametrized constructor
+	Output(Verbosity level, ostream& stream);
+
+	// Setter for the level
+	void setLevel(Verbosity level);
+	// Getter for the level
+	Verbosity getLevel() const;
+	// True if messages of the given level are written
+	bool enabled(Verbosity level) const;
+	// Stream the messages are written to
+	ostream& stream();
+
+	// Narrative output on cout, for objects that are not part of a game
+	static Output& standard();
+	// Reads a level by name ("silent", "summary" or "narrative"), returns false if there is no such level
+	static bool parseLevel(string name, Verbosity& level);
+
+private:
+	Verbosity level;
+	ostream* out;
+};
+
+// Starts a message of the given level. The rest of the << chain is skipped, arguments included, if the level is not shown.
+#define GAME_OUTPUT(output, level) if (!(output).enabled(level)) {} else (output).stream()
@@ -7,9 +7,6 @@
 int main()
 {
 
-    // Random initializer
-    srand((int)time(nullptr));
-
     GameEngine * game = new GameEngine();
 
     // Initializing states
@@ -47,6 +44,9 @@ int main()
     // Create a map from file and assign to this game instance
     string fileName = "COMP-345/Map/Assets/test.map";
     Map* map = MapLoader::createMapfromFile(fileName);
+    if (map == NULL) {
+        return 1;
+    }
     map->validate();
     game->setMap(map);
 
@@ -0,0 +1,97 @@
+#include "Random.h"
+#include <atomic>
+#include <chrono>
+#include <random>
+
+// splitmix64, used to spread a single seed over the four words of state
+static uint64_t splitMix(uint64_t& x) {
+	uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+Random::Random() {
+	setSeed(randomSeed());
+}
+
+Random::Random(uint64_t seed) {
+	setSeed(seed);
+}
+
+void Random::setSeed(uint64_t seed) {
+	this->seed = seed;
+	uint64_t x = seed;
+	for (int i = 0; i < 4; i++) {
+		s[i] = splitMix(x);
+	}
+}
+
+uint64_t Random::getSeed() const {
+	return seed;
+}
+
+void Random::saveState(uint64_t* words) const {
+	words[0] = seed;
+	for (int i = 0; i < 4; i++) {
+		words[i + 1] = s[i];
+	}
+}
+
+void Random::restoreState(const uint64_t* words) {
+	seed = words[0];
+	for (int i = 0; i < 4; i++) {
+		s[i] = words[i + 1];
+	}
+}
+
+uint64_t Random::next() {
+	uint64_t result = rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+
+	return result;
+}
+
+int Random::nextInt(int bound) {
+	if (bound <= 1) {
+		return 0;
+	}
+
+	// Reject the top partial block so every value is equally likely
+	uint64_t range = (uint64_t)bound;
+	uint64_t limit = UINT64_MAX - UINT64_MAX % range;
+	uint64_t r;
+	do {
+		r = next();
+	} while (r >= limit);
+
+	return (int)(r % range);
+}
+
+int Random::nextInt(int low, int high) {
+	return low + nextInt(high - low + 1);
+}
+
+double Random::nextDouble() {
+	// 53 random bits fill the mantissa of a double
+	return (next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+uint64_t Random::randomSeed() {
+	static atomic<uint64_t> counter(0);
+	uint64_t x = (uint64_t)chrono::high_resolution_clock::now().time_since_epoch().count();
+	x ^= (uint64_t)random_device()() << 32;
+	x += counter++ * 0x9E3779B97F4A7C15ULL;
+	return splitMix(x);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+using namespace std;
+
+/* Small, fast pseudo-random number generator (xoshiro256**) owned by each game.
+Two games seeded with the same value make exactly the same random choices, so any game can be replayed from its seed.
+It also satisfies UniformRandomBitGenerator, so it can be passed to std::shuffle. */
+class Random
+{
+public:
+	typedef uint64_t result_type;
+
+	// Default constructor (seeded from the clock and the system's random device)
+	Random();
+	// Parametrized constructor
+	explicit Random(uint64_t seed);
+
+	// Restart the sequence from the given seed
+	void setSeed(uint64_t seed);
+	// Seed the sequence was started from
+	uint64_t getSeed() const;
+
+	// Number of 64-bit words saved by saveState()
+	static const int stateSize = 5;
+	// Copies the seed and the position in the sequence out, or back in, so the sequence can be resumed exactly where it was saved
+	void saveState(uint64_t* words) const;
+	void restoreState(const uint64_t* words);
+
+	// Next raw 64-bit value
+	uint64_t next();
+	// Uniform int in [0, bound)
+	int nextInt(int bound);
+	// Uniform int in [low, high]
+	int nextInt(int low, int high);
+	// Uniform double in [0, 1)
+	double nextDouble();
+
+	// UniformRandomBitGenerator interface
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+	result_type operator()() { return next(); }
+
+	// A seed that has not been handed out before in this process
+	static uint64_t randomSeed();
+
+private:
+	uint64_t seed;
+	uint64_t s[4];
+};
@@ -0,0 +1,236 @@
+#include "Snapshot.h"
+#include "GameEngine.h"
+#include "../Orders/Orders.h"
+#include "../Player/Player.h"
+#include "../Player/PlayerStrategies.h"
+#include "../Cards/Cards.h"
+#include <cstring>
+#include <type_traits>
+
+// Number of ints before the generator's state
+static const int headerSize = 6;
+// Number of card types (see Card::cardType)
+static const int numCardTypes = 5;
+static_assert(sizeof(OrderData) == GameSnapshot::orderSize * sizeof(int32_t), "an order is written as orderSize ints");
+static_assert(is_trivially_copyable<OrderData>::value, "an order is copied to and from the buffer with memcpy");
+
+// Position of a player in the list, -1 if it is not in it (there are only a handful of players)
+static int32_t positionOf(const vector<Player*>& players, Player* player) {
+	for (int i = 0; i < (int)players.size(); i++) {
+		if (players[i] == player) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Position of a territory on the map, -1 for none
+static int32_t positionOf(Map* map, Territory* territory) {
+	return map == nullptr || territory == nullptr ? -1 : map->getPosition(territory->getIndex());
+}
+
+static int32_t positionOf(const vector<State*>& states, State* state) {
+	for (int i = 0; i < (int)states.size(); i++) {
+		if (states[i] == state) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static PlayerStrategy* newStrategy(PlayerStrategy::strategyName name, Player* player) {
+	switch (name) {
+	case PlayerStrategy::Aggressive: return new AggressivePlayerStrategy(player);
+	case PlayerStrategy::Benevolent: return new BenevolentPlayerStrategy(player);
+	case PlayerStrategy::Neutral: return new NeutralPlayerStrategy(player);
+	case PlayerStrategy::Cheater: return new CheaterPlayerStrategy(player);
+	case PlayerStrategy::MonteCarlo: return new MonteCarloPlayerStrategy(player);
+	default: return new HumanPlayerStrategy(player);
+	}
+}
+
+void GameSnapshot::save(GameEngine* game) {
+	buffer.clear();
+	this->game = game;
+	players = game->players;
+
+	Map* map = game->getMap();
+	TerritoryState* state = map != nullptr ? map->getState() : nullptr;
+	int numTerritories = state != nullptr ? state->size() : 0;
+
+	int32_t header[headerSize] = { magic, version, (int32_t)players.size(), numTerritories,
+		positionOf(game->states, game->currentState), positionOf(game->states, game->cmd_currentState) };
+	buffer.insert(buffer.end(), header, header + headerSize);
+
+	uint64_t words[Random::stateSize];
+	game->getRandom()->saveState(words);
+	for (uint64_t word : words) {
+		buffer.push_back((int32_t)(uint32_t)word);
+		buffer.push_back((int32_t)(uint32_t)(word >> 32));
+	}
+
+	const vector<Card*>& deck = game->getDeck()->getCards();
+	buffer.push_back((int32_t)deck.size());
+	for (Card* card : deck) {
+		buffer.push_back(card->enumToInt(card->getCardTypeName()));
+	}
+
+	// The state numbers players in the order they first owned a territory, so its ids are turned into player positions once each
+	vector<int32_t> playerOfId;
+	for (int slot = 0; slot < numTerritories; slot++) {
+		int id = state->getOwnerId(slot);
+		while (id >= (int)playerOfId.size()) {
+			playerOfId.push_back(positionOf(players, state->getPlayer((int)playerOfId.size())));
+		}
+		buffer.push_back(id >= 0 ? playerOfId[id] : -1);
+		buffer.push_back(state->getArmies(slot));
+	}
+
+	for (Player* p : players) {
+		buffer.push_back(p->getPlayerStrategy() != nullptr ? p->getPlayerStrategy()->strN : PlayerStrategy::Human);
+		buffer.push_back(p->getReinforcementPool());
+		buffer.push_back(p->receivedCardThisTurn);
+
+		buffer.push_back((int32_t)p->cannotAttack.size());
+		for (Player* other : p->cannotAttack) {
+			buffer.push_back(positionOf(players, other));
+		}
+
+		Hand* hand = p->getHand();
+		buffer.push_back(hand->getSize());
+		for (int i = 0; i < hand->getSize(); i++) {
+			Card* card = hand->getCardInHand(i);
+			buffer.push_back(card->enumToInt(card->getCardTypeName()));
+		}
+
+		const vector<Territory*>& owned = p->getOwnedTerritories();
+		buffer.push_back((int32_t)owned.size());
+		for (Territory* t : owned) {
+			buffer.push_back(positionOf(map, t));
+		}
+
+		vector<Orders*>& orders = p->getOrdersList()->ordersList;
+		buffer.push_back((int32_t)orders.size());
+		for (Orders* o : orders) {
+			OrderData data = o->toData(map, players);
+			size_t end = buffer.size();
+			buffer.resize(end + orderSize);
+			memcpy(buffer.data() + end, &data, sizeof(data));
+		}
+	}
+}
+
+bool GameSnapshot::restore(GameEngine* game) const {
+	Map* map = game->getMap();
+	int numTerritories = map != nullptr ? map->getState()->size() : 0;
+
+	// Players, cards and states are only valid in the game they came from
+	if (game != this->game || buffer.size() < headerSize || buffer[0] != magic || buffer[1] != version || buffer[2] != (int32_t)players.size() || buffer[3] != numTerritories) {
+		return false;
+	}
+
+	const int32_t* in = buffer.data() + headerSize;
+	// Pending orders are dropped while the arena still holds them, then its memory is reused for the restored ones
+	for (Player* p : players) {
+		p->getOrdersList()->clear();
+	}
+	game->releaseOrders();
+	game->players = players;
+	game->currentState = buffer[4] >= 0 && buffer[4] < (int)game->states.size() ? game->states[buffer[4]] : game->currentState;
+	game->cmd_currentState = buffer[5] >= 0 && buffer[5] < (int)game->states.size() ? game->states[buffer[5]] : game->cmd_currentState;
+
+	uint64_t words[Random::stateSize];
+	for (uint64_t& word : words) {
+		word = (uint64_t)(uint32_t)in[0] | (uint64_t)(uint32_t)in[1] << 32;
+		in += 2;
+	}
+	game->getRandom()->restoreState(words);
+
+	// Cards are only ever moved between the deck and the hands, so the cards already there are handed out again by type
+	vector<Card*> pool[numCardTypes];
+	for (Card* card : game->getDeck()->getCards()) {
+		pool[card->enumToInt(card->getCardTypeName())].push_back(card);
+	}
+	for (Player* p : players) {
+		for (Card* card : p->getHand()->getCardsInHand()) {
+			pool[card->enumToInt(card->getCardTypeName())].push_back(card);
+		}
+	}
+	auto takeCard = [&pool](int32_t type) {
+		if (pool[type].empty()) {
+			return new Card((Card::cardType)type);
+		}
+		Card* card = pool[type].back();
+		pool[type].pop_back();
+		return card;
+	};
+
+	vector<Card*> cards(*in++);
+	for (Card*& card : cards) {
+		card = takeCard(*in++);
+	}
+	game->getDeck()->setCards(cards);
+
+	TerritoryState* state = numTerritories > 0 ? map->getState() : nullptr;
+	for (int slot = 0; slot < numTerritories; slot++) {
+		Player* owner = in[0] >= 0 ? players[in[0]] : nullptr;
+		if (state->getOwner(slot) != owner) {
+			state->setOwner(slot, owner);
+		}
+		state->setArmies(slot, in[1]);
+		in += 2;
+	}
+
+	// A territory may move from one player's list to another's, so every list is emptied before any is refilled
+	for (Player* p : players) {
+		p->restoreOwnedTerritories(map, nullptr, 0);
+	}
+
+	for (Player* p : players) {
+		PlayerStrategy::strategyName strategy = (PlayerStrategy::strategyName)*in++;
+		if (p->getPlayerStrategy() == nullptr || p->getPlayerStrategy()->strN != strategy) {
+			p->setPlayerStrategy(newStrategy(strategy, p));
+		}
+		p->setReinforcementPool(*in++);
+		p->receivedCardThisTurn = *in++ != 0;
+
+		p->cannotAttack.clear();
+		for (int count = *in++; count > 0; count--) {
+			int32_t other = *in++;
+			if (other >= 0) {
+				p->cannotAttack.push_back(players[other]);
+			}
+		}
+
+		cards.resize(*in++);
+		for (Card*& card : cards) {
+			card = takeCard(*in++);
+		}
+		p->getHand()->setCardsInHand(cards);
+
+		int numOwned = *in++;
+		p->restoreOwnedTerritories(map, in, numOwned);
+		in += numOwned;
+
+		vector<Orders*>& orders = p->getOrdersList()->ordersList;
+		for (int count = *in++; count > 0; count--) {
+			OrderData data;
+			memcpy(&data, in, sizeof(data));
+			Orders* order = Orders::fromData(data, game, map, players);
+			if (order != nullptr) {
+				orders.push_back(order);
+			}
+			in += orderSize;
+		}
+	}
+
+	return true;
+}
+
+bool GameSnapshot::empty() const {
+	return buffer.empty();
+}
+
+const vector<int32_t>& GameSnapshot::data() const {
+	return buffer;
+}
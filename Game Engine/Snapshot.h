@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Forward declaration
+class GameEngine;
+class Player;
+
+/* Copy of everything that changes while a game is played, in a flat buffer of ints: the owner and army count of every
+territory, each player's reinforcement pool, strategy, hand, owned territories (in list order), truces and pending orders,
+the cards left in the deck, the engine's state and its random number generator. Restoring a snapshot puts the game back
+exactly where it was, so playing on from it makes the same choices again.
+
+Territories, players, cards and states are written as positions rather than pointers; the snapshot only keeps the list of
+the game's players it was taken from (players removed from the game since are put back on restore). A snapshot can only
+be restored into the game it was taken from, on the same map. The buffer keeps its capacity from one save to the next, so
+saving into the same snapshot again does not grow it. Use GameEngine::saveSnapshot and GameEngine::restoreSnapshot.
+
+Layout, in ints:
+	header:     magic, version, number of players, number of territories, current state, command processor state
+	generator:  Random::stateSize 64-bit words, two ints each (low half first)
+	deck:       number of cards, then the type of each card (see Card::cardType)
+	territory:  owner (player position, -1 for none) and armies, for every territory in map order
+	player:     strategy, reinforcement pool, received a card this turn, then counted lists of: players that cannot be
+	            attacked, card types in hand, owned territory positions, and pending orders (an OrderData each, orderSize ints) */
+class GameSnapshot
+{
+public:
+	// Takes a snapshot of the game, replacing whatever the snapshot held
+	void save(GameEngine* game);
+	// Puts the game back in the state the snapshot was taken in. Returns false, leaving the game untouched, if the snapshot
+	// is empty or was taken from another game.
+	bool restore(GameEngine* game) const;
+
+	bool empty() const;
+	// The flat buffer itself, for storing the snapshot elsewhere
+	const vector<int32_t>& data() const;
+
+	static const int32_t magic = 0x4E535A57; // "WZSN"
+	static const int32_t version = 2;
+	// Ints per pending order, each written as its OrderData
+	static const int orderSize = 4;
+
+private:
+	vector<int32_t> buffer;
+	// The game the snapshot was taken from, the only one it can be restored into
+	GameEngine* game = nullptr;
+	// The game's players when the snapshot was taken, in turn order
+	vector<Player*> players;
+};
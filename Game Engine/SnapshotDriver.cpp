@@ -0,0 +1,131 @@
+#include <iostream>
+#include <chrono>
+#include "GameEngine.h"
+#include "Snapshot.h"
+
+using namespace std;
+
+// Sets up a seeded game on the given map without playing it: territories dealt out in turn, 50 armies and 2 cards each
+static GameEngine* newGame(string mapFileName, uint64_t seed) {
+	GameEngine* game = new GameEngine();
+	game->getOutput().setLevel(Verbosity::Silent);
+	game->newState("start");
+	game->setSeed(seed);
+	game->resetContext();
+
+	Map* map = MapLoader::createMapfromFile(mapFileName);
+	if (map == NULL) {
+		delete game;
+		return nullptr;
+	}
+	game->setMap(map);
+
+	Player* aggressive = new Player("Aggressive", new Hand, game, new AggressivePlayerStrategy(NULL));
+	Player* benevolent = new Player("Benevolent", new Hand, game, new BenevolentPlayerStrategy(NULL));
+	for (Player* p : { aggressive, benevolent }) {
+		p->getPlayerStrategy()->setPlayer(p);
+		game->addPlayer(p);
+	}
+
+	Player* neutral = game->getNeutralPlayer();
+	vector<Territory*> territories = map->getTerritories();
+	for (int i = 0; i < (int)territories.size(); i++) {
+		Player* p = i % 3 == 2 ? neutral : (i % 3 == 0 ? aggressive : benevolent);
+		p->addOwnedTerritory(territories[i]);
+	}
+	for (Player* p : { aggressive, benevolent }) {
+		p->setReinforcementPool(50);
+		p->getHand()->addHand(game->getDeck()->draw());
+		p->getHand()->addHand(game->getDeck()->draw());
+	}
+	return game;
+}
+
+// Plays a round the way the main game loop does, false once a player has been removed or has won
+static bool playRound(GameEngine* game) {
+	int numTerritories = game->getMap()->getTerritories().size();
+	for (Player* p : game->players) {
+		int numOwned = game->getMap()->getState()->countOwnedBy(p);
+		if ((numOwned == 0 && p->getName() != "NEUTRAL") || numOwned >= numTerritories) {
+			return false;
+		}
+	}
+
+	game->reinforcementPhase();
+	game->issueOrdersPhase();
+	game->executeOrdersPhase();
+	return true;
+}
+
+// Plays up to 'rounds' rounds from the snapshot and returns a snapshot of where the game ended up
+static GameSnapshot playFrom(GameEngine* game, const GameSnapshot& start, int rounds) {
+	game->restoreSnapshot(start);
+	for (int i = 0; i < rounds && playRound(game); i++) {}
+
+	GameSnapshot end;
+	game->saveSnapshot(end);
+	return end;
+}
+
+int main(int argc, char* argv[]) {
+	string mapFileName = argc > 1 ? argv[1] : "../Map/Assets/solar.map";
+	GameEngine* game = newGame(mapFileName, 345);
+	if (game == nullptr) {
+		return 1;
+	}
+
+	cout << "Game snapshots on " << mapFileName << "\n" << endl;
+
+	// Playing on twice from the same snapshot must end in the same state, between rounds and with orders still pending
+	for (int i = 0; i < 3; i++) {
+		playRound(game);
+	}
+	GameSnapshot betweenRounds;
+	game->saveSnapshot(betweenRounds);
+	GameSnapshot first = playFrom(game, betweenRounds, 10);
+	GameSnapshot second = playFrom(game, betweenRounds, 10);
+	cout << "Replay from a snapshot between rounds: " << (first.data() == second.data() ? "same game" : "DIFFERENT GAME") << endl;
+
+	game->restoreSnapshot(betweenRounds);
+	game->reinforcementPhase();
+	game->issueOrdersPhase();
+	GameSnapshot pendingOrders;
+	game->saveSnapshot(pendingOrders);
+	int numPending = 0;
+	for (Player* p : game->players) {
+		numPending += p->getOrdersList()->ordersList.size();
+	}
+	auto finishRound = [&]() {
+		game->restoreSnapshot(pendingOrders);
+		game->executeOrdersPhase();
+		for (int i = 0; i < 10 && playRound(game); i++) {}
+		GameSnapshot end;
+		game->saveSnapshot(end);
+		return end;
+	};
+	first = finishRound();
+	second = finishRound();
+	cout << "Replay from a snapshot with " << numPending << " pending orders: " << (first.data() == second.data() ? "same game" : "DIFFERENT GAME") << endl;
+
+	// Cost of a save and of a restore, as a search would use them
+	const int runs = 10000;
+	GameSnapshot snapshot;
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < runs; i++) {
+		game->saveSnapshot(snapshot);
+	}
+	double saveUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / runs;
+
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < runs; i++) {
+		game->restoreSnapshot(betweenRounds);
+	}
+	double restoreUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / runs;
+
+	cout << "\n" << game->getMap()->getTerritories().size() << " territories, " << snapshot.data().size() * sizeof(int32_t) << " bytes per snapshot: save "
+		<< saveUs << " us, restore " << restoreUs << " us (average of " << runs << ")" << endl;
+
+	game->clearGame();
+	delete game;
+	return 0;
+}
@@ -1,13 +1,16 @@
 #include <iostream>
 #include "../CommandProcessor/CommandProcessor.h"
 #include "GameEngine.h"
+#include "../LoggingObserver/BinaryLogObserver.h"
 using namespace std;
 
-int main() {
+// Pass --binary-log to write the log to gamelog.bin as binary records instead of gamelog.txt (see LogDecoderDriver)
+int main(int argc, char* argv[]) {
     const int CARDS_IN_DECK = 52;
 
     // Instantiate Observer object
-    Observer *_observer = new LogObserver();
+    bool binaryLog = argc > 1 && string(argv[1]) == "--binary-log";
+    Observer *_observer = binaryLog ? new BinaryLogObserver() : new LogObserver();
 
     CommandProcessor *commandprocessor = new CommandProcessor(_observer);
 
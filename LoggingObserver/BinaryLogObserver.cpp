@@ -0,0 +1,183 @@
+#include "BinaryLogObserver.h"
+#include <iterator>
+
+// All Methods and Classes have comments in the BinaryLogObserver header file
+//////////////////////////////////////////////////////////////////////////////
+const char BinaryLogObserver::magic[4] = { 'W', 'Z', 'L', 'G' };
+
+// Appends a number to the buffer as a LEB128 varint
+static void writeVarint(string& buffer, uint64_t value) {
+	while (value >= 0x80) {
+		buffer += (char)((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	buffer += (char)value;
+}
+
+// Maps signed numbers to unsigned ones so small negative numbers also stay small (0, -1, 1, -2... become 0, 1, 2, 3...)
+static uint64_t zigzag(int64_t value) {
+	return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value) {
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+BinaryLogObserver::BinaryLogObserver() : BinaryLogObserver("gamelog.bin") {}
+
+BinaryLogObserver::BinaryLogObserver(string fileName) : LogObserver(fileName, true) {
+	string header(magic, sizeof(magic));
+	header += (char)version;
+	write(header);
+}
+
+void BinaryLogObserver::Update(ILoggable* _loggable_object) {
+	LogRecord record;
+	if (!_loggable_object->toLogRecord(record)) {
+		record = LogRecord();
+		record.text = _loggable_object->stringToLog();
+	}
+	Update(record);
+}
+
+void BinaryLogObserver::Update(const LogRecord& record) {
+	lock_guard<mutex> lock(encodeMutex);
+	buffer.clear();
+
+	uint32_t ids[] = { intern(record.player), intern(record.otherPlayer), intern(record.source), intern(record.target),
+		intern(record.text), intern(record.detail) };
+
+	buffer += (char)record.event;
+	writeVarint(buffer, (uint64_t)record.game);
+	writeVarint(buffer, (uint64_t)record.outcome);
+	writeVarint(buffer, zigzag(record.armies));
+	for (uint32_t id : ids) {
+		writeVarint(buffer, id);
+	}
+	write(buffer);
+}
+
+bool BinaryLogObserver::acceptsRecords() { return true; }
+
+uint32_t BinaryLogObserver::intern(const string& s) {
+	if (s.empty()) return 0;
+
+	auto found = stringIds.find(s);
+	if (found != stringIds.end()) return found->second;
+
+	uint32_t id = (uint32_t)stringIds.size() + 1;
+	stringIds.emplace(s, id);
+	buffer += (char)stringTag;
+	writeVarint(buffer, id);
+	writeVarint(buffer, s.size());
+	buffer += s;
+	return id;
+}
+
+BinaryLogReader::BinaryLogReader(string fileName) {
+	ifstream file(fileName, ifstream::binary);
+	if (!file) {
+		error = "Could not open " + fileName;
+		return;
+	}
+	data.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	if (!readHeader()) {
+		pos = 0;
+		if (error.empty()) error = fileName + " is not a binary game log";
+	}
+}
+
+bool BinaryLogReader::isValid() {
+	return pos > 0;
+}
+
+string BinaryLogReader::getError() {
+	return error;
+}
+
+bool BinaryLogReader::readHeader() {
+	if (data.size() - pos < sizeof(BinaryLogObserver::magic) + 1
+		|| data.compare(pos, sizeof(BinaryLogObserver::magic), BinaryLogObserver::magic, sizeof(BinaryLogObserver::magic)) != 0) {
+		return false;
+	}
+	pos += sizeof(BinaryLogObserver::magic);
+	if ((uint8_t)data[pos] != BinaryLogObserver::version) {
+		error = "Unsupported log version " + to_string((uint8_t)data[pos]);
+		return false;
+	}
+	pos++;
+	// Every session numbers its strings from 1 again
+	strings.assign(1, "");
+	return true;
+}
+
+bool BinaryLogReader::readVarint(uint64_t& value) {
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (pos >= data.size()) return false;
+		uint8_t byte = (uint8_t)data[pos++];
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) return true;
+	}
+	return false;
+}
+
+bool BinaryLogReader::readString(uint64_t id, string& s) {
+	if (id >= strings.size()) return false;
+	s = strings[id];
+	return true;
+}
+
+bool BinaryLogReader::next(LogRecord& record) {
+	if (!isValid()) return false;
+
+	while (pos < data.size()) {
+		size_t start = pos;
+		uint8_t tag = (uint8_t)data[pos];
+
+		// A new session appended to the same file
+		if (tag == (uint8_t)BinaryLogObserver::magic[0]) {
+			if (!readHeader()) {
+				if (error.empty()) error = "Damaged session header at byte " + to_string(start);
+				return false;
+			}
+			continue;
+		}
+		pos++;
+
+		if (tag == BinaryLogObserver::stringTag) {
+			uint64_t id, length;
+			if (!readVarint(id) || !readVarint(length) || length > data.size() - pos || id != strings.size()) {
+				error = "Damaged string definition at byte " + to_string(start);
+				return false;
+			}
+			strings.push_back(data.substr(pos, length));
+			pos += length;
+			continue;
+		}
+
+		if (tag > (uint8_t)LogEvent::TournamentEnded) {
+			error = "Unknown record tag " + to_string(tag) + " at byte " + to_string(start);
+			return false;
+		}
+
+		uint64_t game = 0, outcome = 0, armies = 0, ids[6] = {};
+		bool complete = readVarint(game) && readVarint(outcome) && readVarint(armies);
+		for (uint64_t& id : ids) {
+			complete = complete && readVarint(id);
+		}
+		if (!complete
+			|| !readString(ids[0], record.player) || !readString(ids[1], record.otherPlayer)
+			|| !readString(ids[2], record.source) || !readString(ids[3], record.target)
+			|| !readString(ids[4], record.text) || !readString(ids[5], record.detail)) {
+			error = "Damaged record at byte " + to_string(start);
+			return false;
+		}
+		record.event = (LogEvent)tag;
+		record.game = (int)game;
+		record.outcome = (int)outcome;
+		record.armies = (int)unzigzag(armies);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "LoggingObserver.h"
+#include <unordered_map>
+#include <vector>
+
+/* Log observer that writes typed records to gamelog.bin instead of text lines.
+
+File layout: every session starts with the header "WZLG" followed by a version byte. Every record after it starts with
+a one byte tag. Numbers are written as LEB128 varints, 7 bits per byte, so small numbers take a single byte.
+	tag 1 (string):  id, length, bytes. Defines the string that later records refer to by id.
+	other tags (event, see LogEvent): game, outcome, zigzag(armies), then the string ids of player, otherPlayer,
+	source, target, text and detail, 0 meaning no string.
+Names, commands and order types repeat all the time, so each one is written out once per session and every record
+after that only takes a few bytes (about 10). Records have a fixed set of fields rather than a fixed size, and players and
+territories are referred to by the ids of their names, since that is what LogRecord carries. Use BinaryLogReader, or the LogDecoderDriver tool, to turn a log back into text. */
+class BinaryLogObserver : public LogObserver
+{
+public:
+	// Default constructor, opens gamelog.bin and writes the session header
+	BinaryLogObserver();
+	// Opens the given log file and writes the session header
+	explicit BinaryLogObserver(string fileName);
+	// Queues the record of a loggable object, or its text as a plain entry if it has no record
+	void Update(ILoggable* _loggable_object);
+	// Queues a record
+	void Update(const LogRecord& record);
+	// Records are what this observer writes
+	bool acceptsRecords();
+
+	static const char magic[4];
+	static const uint8_t version = 1;
+	// Tag of a string definition
+	static const uint8_t stringTag = 1;
+
+private:
+	// Held while a record is encoded and queued, so string definitions are always written before their first use
+	mutex encodeMutex;
+	unordered_map<string, uint32_t> stringIds;
+	string buffer;
+
+	// Id of the string, writing its definition to the buffer if this is its first use (0 for an empty string)
+	uint32_t intern(const string& s);
+};
+
+// Reads the records of a binary log back, one at a time
+class BinaryLogReader
+{
+public:
+	// Reads the whole log file
+	explicit BinaryLogReader(string fileName);
+	// True if the file could be opened and starts with a valid header
+	bool isValid();
+	// Reads the next event record, false at the end of the log or if the rest of the log is damaged
+	bool next(LogRecord& record);
+	// Why the last call to next() returned false ("" at the end of the log)
+	string getError();
+
+private:
+	string data;
+	size_t pos = 0;
+	string error;
+	// Strings defined so far in the current session, indexed by id
+	vector<string> strings;
+
+	bool readHeader();
+	bool readVarint(uint64_t& value);
+	bool readString(uint64_t id, string& s);
+};
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <string>
+
+#include "BinaryLogObserver.h"
+#include "../Orders/Orders.h"
+
+using namespace std;
+
+// Quotes a CSV field if it has a comma, a quote or a line break in it
+static string csvField(const string& field) {
+    if (field.find_first_of(",\"\n") == string::npos) {
+        return field;
+    }
+    string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static const char* eventName(LogEvent event) {
+    switch (event) {
+    case LogEvent::StateChanged: return "StateChanged";
+    case LogEvent::CommandIssued: return "CommandIssued";
+    case LogEvent::CommandInserted: return "CommandInserted";
+    case LogEvent::OrderIssued: return "OrderIssued";
+    case LogEvent::OrderExecuted: return "OrderExecuted";
+    case LogEvent::OwnershipChanged: return "OwnershipChanged";
+    case LogEvent::TournamentEnded: return "TournamentEnded";
+    default: return "Text";
+    }
+}
+
+// One line of text per record, in the same words as the text log where there is an equivalent
+static string describe(const LogRecord& record) {
+    string out = record.game > 0 ? "[Game " + to_string(record.game) + "] " : "";
+    switch (record.event) {
+    case LogEvent::StateChanged:
+        return out + "Current GameEngine State: " + record.text;
+    case LogEvent::CommandIssued:
+        return out + "Command issued: " + record.text + "\nCommand's effect: " + record.detail;
+    case LogEvent::CommandInserted:
+        return out + "Inserted command: " + record.text + " into the list.";
+    case LogEvent::OrderIssued:
+        return out + record.player + " inserted Order: " + record.text + " into the list.";
+    case LogEvent::OrderExecuted:
+        out += "Order: " + record.text + ", Outcome: " + outcomeName((OrderOutcome)record.outcome);
+        if (!record.player.empty()) out += ", Player: " + record.player;
+        if (!record.otherPlayer.empty()) out += ", Enemy: " + record.otherPlayer;
+        if (!record.source.empty()) out += ", From: " + record.source;
+        if (!record.target.empty()) out += ", To: " + record.target;
+        if (record.armies != 0) out += ", Armies: " + to_string(record.armies);
+        if (!record.detail.empty()) out += ", Effect: " + record.detail;
+        return out;
+    case LogEvent::OwnershipChanged:
+        return out + record.target + " taken by " + record.player
+            + (record.otherPlayer.empty() ? "" : " from " + record.otherPlayer) + " (" + to_string(record.armies) + " armies)";
+    default:
+        return out + record.text;
+    }
+}
+
+// Turns a binary game log written by BinaryLogObserver back into text, or into CSV with --csv
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <binary log file> [--csv]" << endl;
+        return 1;
+    }
+    bool csv = argc > 2 && string(argv[2]) == "--csv";
+
+    BinaryLogReader reader(argv[1]);
+    if (!reader.isValid()) {
+        cerr << reader.getError() << endl;
+        return 1;
+    }
+
+    if (csv) {
+        cout << "event,game,outcome,armies,player,otherPlayer,source,target,text,detail" << '\n';
+    }
+    LogRecord record;
+    while (reader.next(record)) {
+        if (csv) {
+            cout << eventName(record.event) << ',' << record.game << ','
+                << (record.event == LogEvent::OrderExecuted ? outcomeName((OrderOutcome)record.outcome) : "") << ','
+                << record.armies << ',' << csvField(record.player) << ',' << csvField(record.otherPlayer) << ','
+                << csvField(record.source) << ',' << csvField(record.target) << ',' << csvField(record.text) << ','
+                << csvField(record.detail) << '\n';
+        }
+        else {
+            cout << describe(record) << '\n';
+        }
+    }
+
+    if (!reader.getError().empty()) {
+        cerr << reader.getError() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,10 +1,15 @@
 #include "../LoggingObserver/LoggingObserver.h"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
 
 // All Methods and Classes have comments in the LoggingObserver header file
 //////////////////////////////////////////////////////////////////////////////
 ILoggable::ILoggable() {}
 ILoggable::ILoggable(const ILoggable& s) {}
 ILoggable& ILoggable::operator=(const ILoggable& s) { return *this; }
+bool ILoggable::toLogRecord(LogRecord&) { return false; }
 
 Subject::Subject() {}
 Subject::~Subject() { this->_observer = nullptr; }
@@ -24,24 +29,256 @@ void Subject::Detach() {
 }
 
 void Subject::Notify(ILoggable* _loggable_object) {
-	if (_observer != nullptr) _observer->Update(_loggable_object);
+	if (isObserved()) _observer->Update(_loggable_object);
+}
+
+bool Subject::isObserved() {
+	return _observer != nullptr && _observer->isEnabled();
+}
+
+void Subject::Notify(const LogRecord& record) {
+	if (isRecorded()) _observer->Update(record);
+}
+
+bool Subject::isRecorded() {
+	return isObserved() && _observer->acceptsRecords();
 }
 
 Observer::Observer() {}
 Observer::Observer(const Observer& s) {}
 Observer& Observer::operator=(const Observer& s) { return *this; }
+Observer::~Observer() {}
+void Observer::flush() {}
+bool Observer::isEnabled() { return true; }
+void Observer::Update(const LogRecord&) {}
+bool Observer::acceptsRecords() { return false; }
+
+// Every live LogObserver, so that they can all be flushed when the program exits or terminates
+static mutex liveLoggersMutex;
+static vector<LogObserver*> liveLoggers;
+
+static terminate_handler previousTerminate = nullptr;
 
-LogObserver::LogObserver() {}
-LogObserver::LogObserver(const LogObserver& s) {}
+static void flushOnTerminate() {
+	LogObserver::flushAll(true);
+	if (previousTerminate != nullptr) previousTerminate();
+	abort();
+}
+
+// Installed once, by the first LogObserver. There are no handlers for crash signals: writing out the buffers allocates and
+// goes through ofstream, which is not safe in a signal handler, so entries still queued when the program crashes are lost.
+static void installFlushHandlers() {
+	static once_flag installed;
+	call_once(installed, []() {
+		atexit([]() { LogObserver::flushAll(); });
+		previousTerminate = set_terminate(flushOnTerminate);
+	});
+}
+
+LogObserver::LogObserver() : LogObserver("gamelog.txt", false) {}
+
+LogObserver::LogObserver(string fileName, bool binary) : ring(new Slot[capacity]), binary(binary) {
+	for (size_t i = 0; i < capacity; i++) {
+		ring[i].sequence.store(i, memory_order_relaxed);
+	}
+
+	// append setting. If the log file is not found, it will create it.
+	logfile.open(fileName, binary ? ofstream::app | ofstream::binary : ofstream::app);
+
+	installFlushHandlers();
+	{
+		lock_guard<mutex> lock(liveLoggersMutex);
+		liveLoggers.push_back(this);
+	}
+	writer = thread(&LogObserver::writerLoop, this);
+}
+LogObserver::LogObserver(const LogObserver& s) : LogObserver() {}
 LogObserver& LogObserver::operator=(const LogObserver& s) { return *this; }
 
+LogObserver::~LogObserver()
+{
+	{
+		lock_guard<mutex> lock(liveLoggersMutex);
+		liveLoggers.erase(find(liveLoggers.begin(), liveLoggers.end(), this));
+	}
+	{
+		lock_guard<mutex> lock(waitMutex);
+		stopping = true;
+	}
+	wakeWriter.notify_one();
+	writer.join();
+
+	lock_guard<mutex> lock(drainMutex);
+	while (drain() > 0) {}
+	logfile.close();
+}
+
 void LogObserver::Update(ILoggable* _loggable_object)
 {
-	// opening output file stream
-	ofstream logfile;
-	logfile.open("gamelog.txt", ofstream::app); // append setting. If gamelog.txt is not found, it will create it.
-	logfile << _loggable_object->stringToLog() << endl; // output the stringToLog to the output file
-	logfile.close(); // close the output file stream
+	string toLog = _loggable_object->stringToLog();
+	write(toLog);
+}
+
+void LogObserver::write(string& toLog)
+{
+	while (!push(toLog)) {
+		// The buffer is full: wake the writer up and wait for it to make room
+		wakeWriter.notify_one();
+		this_thread::yield();
+	}
+
+	// Without a writer thread (the logger is being destroyed), the entry is written right away
+	if (stopping) {
+		lock_guard<mutex> lock(drainMutex);
+		drain();
+		return;
+	}
+
+	// Start writing early when the buffer is filling up, rather than waiting for the writer to wake up on its own
+	if (enqueuePos.load(memory_order_relaxed) - dequeuePos.load(memory_order_relaxed) >= capacity / 2) {
+		wakeWriter.notify_one();
+	}
+}
+
+void LogObserver::flush()
+{
+	size_t target = enqueuePos.load();
+
+	if (stopping) {
+		lock_guard<mutex> lock(drainMutex);
+		while (written < target && drain() > 0) {}
+		return;
+	}
+
+	unique_lock<mutex> lock(waitMutex);
+	wakeWriter.notify_one();
+	flushed.wait(lock, [&]() { return written >= target || stopping; });
+}
+
+void LogObserver::setEnabled(bool enabled)
+{
+	this->enabled = enabled;
+}
+
+bool LogObserver::isEnabled()
+{
+	return enabled;
+}
+
+void LogObserver::flushAll(bool terminating)
+{
+	// std::terminate can be called while these locks are held (even by the terminating thread), so then they are only tried
+	unique_lock<mutex> registryLock(liveLoggersMutex, defer_lock);
+	if (!terminating) registryLock.lock();
+	else if (!registryLock.try_lock()) return;
+
+	for (LogObserver* logger : liveLoggers) {
+		unique_lock<mutex> lock(logger->drainMutex, defer_lock);
+		if (!terminating) lock.lock();
+		else if (!lock.try_lock()) continue;
+
+		while (logger->drain() > 0) {}
+	}
+}
+
+/* Ring buffer from Dmitry Vyukov's bounded queue: each slot's sequence number says whose turn it is. A slot at position pos
+can be written when its sequence is pos, and read when it is pos + 1. Writers claim a position with a compare-and-swap,
+so several game threads can log at once without a lock. */
+bool LogObserver::push(string& entry)
+{
+	size_t pos = enqueuePos.load(memory_order_relaxed);
+	Slot* slot;
+
+	for (;;) {
+		slot = &ring[pos & (capacity - 1)];
+		size_t sequence = slot->sequence.load(memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)pos;
+
+		if (difference == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+		}
+		else if (difference < 0) {
+			return false; // full
+		}
+		else {
+			pos = enqueuePos.load(memory_order_relaxed);
+		}
+	}
+
+	slot->entry = move(entry);
+	slot->sequence.store(pos + 1, memory_order_release);
+	return true;
+}
+
+bool LogObserver::pop(string& entry)
+{
+	size_t pos = dequeuePos.load(memory_order_relaxed);
+	Slot* slot;
+
+	for (;;) {
+		slot = &ring[pos & (capacity - 1)];
+		size_t sequence = slot->sequence.load(memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+		if (difference == 0) {
+			if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+		}
+		else if (difference < 0) {
+			return false; // empty
+		}
+		else {
+			pos = dequeuePos.load(memory_order_relaxed);
+		}
+	}
+
+	entry = move(slot->entry);
+	slot->sequence.store(pos + capacity, memory_order_release);
+	return true;
+}
+
+size_t LogObserver::drain()
+{
+	string batch;
+	string entry;
+	size_t count = 0;
+
+	// Entries are joined so the whole batch goes to the file in one write
+	while (count < capacity && pop(entry)) {
+		batch += entry;
+		if (!binary) batch += '\n';
+		count++;
+	}
+
+	if (count > 0) {
+		logfile.write(batch.data(), batch.size());
+		logfile.flush();
+		written += count;
+	}
+	return count;
+}
+
+void LogObserver::writerLoop()
+{
+	unique_lock<mutex> lock(waitMutex);
+
+	while (!stopping) {
+		lock.unlock();
+		size_t count;
+		{
+			lock_guard<mutex> drainLock(drainMutex);
+			count = drain();
+		}
+		lock.lock();
+
+		if (count > 0) {
+			flushed.notify_all();
+		}
+		else {
+			// Nothing to write: sleep until woken up, or check again in a little while
+			wakeWriter.wait_for(lock, chrono::milliseconds(20));
+		}
+	}
+	flushed.notify_all();
 }
 
 ostream& operator<<(ostream& os, const ILoggable& s) { return os; }
@@ -3,9 +3,36 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
 using namespace std;
 
+// Kind of event described by a LogRecord (the values are also the record tags of the binary log, see BinaryLogObserver)
+enum class LogEvent : uint8_t { None = 0, StateChanged = 2, CommandIssued, CommandInserted, OrderIssued, OrderExecuted, OwnershipChanged, TournamentEnded };
+
+// Typed description of an event, for observers that store events as data rather than as text.
+// Only the fields that apply to the event are set.
+struct LogRecord
+{
+	LogEvent event = LogEvent::None;
+	int game = 0; // Number of the tournament game the event happened in (0 outside of tournaments)
+	int outcome = 0; // Outcome of an executed order (see OrderOutcome)
+	int armies = 0;
+	string player; // Player the event is about (owner of the order, new owner of the territory)
+	string otherPlayer; // Enemy player, or previous owner of the territory
+	string source; // Territory the armies come from
+	string target; // Territory the event happened to
+	string text; // Order type, command, state, or tournament summary
+	string detail; // Effect of a command, or custom effect of an order
+};
+
 // ILoggable class, all derived classes must implement stringToLog()
+// Subjects keep what they log as typed data and only build the text in stringToLog(), which is only called by an observer
+// that writes it out, so nothing is formatted when logging is off.
 class ILoggable
 {
 public:
@@ -19,6 +46,8 @@ public:
 	friend ostream& operator<<(ostream& os, const ILoggable& s);
 	// Implemented by a derived class, must return a string that represents the class
 	virtual string stringToLog() = 0;
+	// Fills in a typed record of what is logged, returns false if the class has no record (the default)
+	virtual bool toLogRecord(LogRecord& record);
 };
 
 // Observer abstract class
@@ -33,24 +62,91 @@ public:
 	Observer& operator=(const Observer& s);
 	// Stream insertion operator (unused)
 	friend ostream& operator<<(ostream& os, const Observer& s);
+	// Destructor
+	virtual ~Observer();
 	// Abstract Update method to be defined by LogObserver
 	virtual void Update(ILoggable* _loggable_object) = 0;
+	// Update with a record that has no ILoggable behind it, such as an ownership change (ignored by default)
+	virtual void Update(const LogRecord& record);
+	// True if the observer uses the records passed to Update(const LogRecord&) (false by default)
+	virtual bool acceptsRecords();
+	// Makes sure everything passed to Update so far has been written out (nothing to do by default)
+	virtual void flush();
+	// False if the observer does not want any updates for now, so subjects skip notifying it (always true by default)
+	virtual bool isEnabled();
 };
 
-// Observer implementation class which outputs to the log file
+/* Observer implementation class which outputs to the log file.
+Update() only puts the entry in a bounded lock-free ring buffer. A background thread keeps gamelog.txt open and writes
+the queued entries out in batches, one write per batch. If the buffer is full, Update() waits for the writer to catch up.
+Everything still queued is written out when the program exits, or terminates on an uncaught exception. */
 class LogObserver : public Observer
 {
 public:
-	// Default constructor (unused)
+	// Default constructor, opens the log file and starts the writer thread
 	LogObserver();
-	// Copy constructor (unused)
+	// Copy constructor (the copy has its own buffer and writer thread)
 	LogObserver(const LogObserver& s);
 	// Assignment operator (unused)
 	LogObserver& operator=(const LogObserver& s);
+	// Destructor, writes out what is left and stops the writer thread
+	~LogObserver();
 	// Stream insertion operator (unused)
 	friend ostream& operator<<(ostream& os, const LogObserver& s);
-	// Will output the stringToLog implementation from a derived class of ILoggable into the log file
+	// Will queue the stringToLog implementation from a derived class of ILoggable to be written to the log file
 	void Update(ILoggable* _loggable_object);
+	using Observer::Update;
+	// Waits until every entry queued so far is in the log file
+	void flush();
+	// Turns logging on or off, while logging is off nothing is formatted or written
+	void setEnabled(bool enabled);
+	bool isEnabled();
+	// Writes out the entries queued in every log observer (called when the program exits or terminates).
+	// When terminating, locks that may never be released are only tried, and loggers in the middle of a write are skipped.
+	static void flushAll(bool terminating = false);
+
+protected:
+	// Opens the given log file. Entries of a binary log are written as they are, without a line break after each one.
+	LogObserver(string fileName, bool binary);
+	// Queues an entry to be written to the log file
+	void write(string& entry);
+
+private:
+	// One entry of the ring buffer. sequence tells whether the entry is free to write or ready to read.
+	struct Slot {
+		atomic<size_t> sequence;
+		string entry;
+	};
+
+	// Number of entries the buffer can hold (a power of two)
+	static const size_t capacity = 8192;
+
+	unique_ptr<Slot[]> ring;
+	atomic<size_t> enqueuePos{ 0 };
+	atomic<size_t> dequeuePos{ 0 };
+	// Number of entries written to the file so far
+	atomic<size_t> written{ 0 };
+	atomic<bool> stopping{ false };
+	atomic<bool> enabled{ true };
+
+	bool binary = false;
+	ofstream logfile;
+	thread writer;
+	// Held while entries are taken out of the buffer and written
+	mutex drainMutex;
+	// Used to put the writer to sleep and to wait for a flush
+	mutex waitMutex;
+	condition_variable wakeWriter;
+	condition_variable flushed;
+
+	// Adds an entry to the buffer, false if it is full
+	bool push(string& entry);
+	// Takes the oldest entry out of the buffer, false if it is empty
+	bool pop(string& entry);
+	// Writes out the queued entries (drainMutex must be held), returns how many were written
+	size_t drain();
+	// Body of the writer thread
+	void writerLoop();
 };
 
 // Subject class, all derived classes can Attach() or Detach() itself from the observer
@@ -74,6 +170,12 @@ public:
 	void Detach();
 	// Calls the update method in Observer/LogObserver
 	void Notify(ILoggable* _loggable_object);
+	// Passes a record to the observer, if it accepts records
+	void Notify(const LogRecord& record);
+	// True if the observer accepts records, so there is a point in building them
+	bool isRecorded();
+	// True if an enabled observer is attached, i.e. if a Notify() would be written out
+	bool isObserved();
 private:
 	// Observer object
 	Observer* _observer = nullptr;
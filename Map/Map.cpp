@@ -11,8 +11,23 @@
 #include <vector>
 #include <tuple>
 #include <exception>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <unordered_map>
 #include "Map.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 
 
@@ -32,15 +47,15 @@ Continent::Continent(const Continent &c) {
 	this->armies = c.armies;
 }
 
-string Continent::getName() {
+string Continent::getName() const {
 	return this->name;
 }
 
-int Continent::getArmies() {
+int Continent::getArmies() const {
 	return this->armies;
 }
 
-int Continent::getIndex()
+int Continent::getIndex() const
 {
 	return this->continentIndex;
 }
@@ -68,6 +83,271 @@ Continent::~Continent() {
 
 }
 	
+// **************************************
+// TERRITORY STATE IMPLEMENTATION
+// **************************************
+
+void TerritoryState::resize(int size) {
+	ownerIds.resize(size, -1);
+	armies.resize(size, 0);
+}
+
+int TerritoryState::size() {
+	return (int)ownerIds.size();
+}
+
+int TerritoryState::getOwnerId(int slot) {
+	return ownerIds[slot];
+}
+
+Player* TerritoryState::getOwner(int slot) {
+	return getPlayer(ownerIds[slot]);
+}
+
+void TerritoryState::setOwner(int slot, Player* player) {
+	int id = registerPlayer(player);
+
+	if (ownerIds[slot] != id) {
+		int previousId = ownerIds[slot];
+		transferContinent(slot, previousId, id);
+		transferCount(previousId, id);
+		ownerIds[slot] = id;
+		transferFrontier(slot, previousId, id);
+		epoch++;
+	}
+}
+
+void TerritoryState::setContinents(vector<int> slotContinents, vector<int> bonuses) {
+	int numContinents = (int)bonuses.size();
+
+	this->slotContinent = slotContinents;
+	this->slotContinent.resize(ownerIds.size(), -1);
+	this->continentArmies = bonuses;
+	this->continentSizes.assign(numContinents, 0);
+
+	for (int c : this->slotContinent) {
+		if (c >= 0 && c < numContinents) {
+			continentSizes[c]++;
+		}
+	}
+
+	continentCounts.assign(players.size() * numContinents, 0);
+	continentBonus.assign(players.size(), 0);
+}
+
+// Only the continent whose count crosses its size changes a player's bonus
+void TerritoryState::transferContinent(int slot, int fromId, int toId) {
+	int numContinents = (int)continentSizes.size();
+	int c = slot < (int)slotContinent.size() ? slotContinent[slot] : -1;
+
+	if (c < 0 || c >= numContinents) {
+		return;
+	}
+
+	if (fromId != -1) {
+		int& count = continentCounts[fromId * numContinents + c];
+		if (count == continentSizes[c]) {
+			continentBonus[fromId] -= continentArmies[c];
+		}
+		count--;
+	}
+
+	if (toId != -1) {
+		int& count = continentCounts[toId * numContinents + c];
+		count++;
+		if (count == continentSizes[c]) {
+			continentBonus[toId] += continentArmies[c];
+		}
+	}
+}
+
+void TerritoryState::transferCount(int fromId, int toId) {
+	if (fromId != -1 && --ownedCounts[fromId] == 0 && !eventPending[fromId]) {
+		eventPending[fromId] = true;
+		ownershipEvents.push_back(fromId);
+	}
+	if (toId != -1 && ++ownedCounts[toId] == (int)ownerIds.size() && !eventPending[toId]) {
+		eventPending[toId] = true;
+		ownershipEvents.push_back(toId);
+	}
+}
+
+void TerritoryState::takeOwnershipEvents(vector<Player*>& players) {
+	for (int id : ownershipEvents) {
+		players.push_back(this->players[id]);
+		eventPending[id] = false;
+	}
+	ownershipEvents.clear();
+}
+
+void TerritoryState::setAdjacency(const vector<int>* offsets, const vector<int>* adjacency) {
+	this->adjacencyOffsets = offsets;
+	this->adjacency = adjacency;
+
+	neighbourCounts.assign(players.size() * ownerIds.size(), 0);
+	frontierPositions.assign(players.size() * ownerIds.size(), -1);
+	frontiers.assign(players.size(), vector<int>());
+}
+
+// Only the neighbours of the slot that changed hands can enter or leave a frontier, besides the slot itself
+void TerritoryState::transferFrontier(int slot, int fromId, int toId) {
+	if (adjacency == nullptr) {
+		return;
+	}
+
+	int numSlots = (int)ownerIds.size();
+	for (int e = (*adjacencyOffsets)[slot]; e < (*adjacencyOffsets)[slot + 1]; e++) {
+		int neighbour = (*adjacency)[e];
+
+		if (fromId != -1 && --neighbourCounts[fromId * numSlots + neighbour] == 0 && ownerIds[neighbour] != fromId) {
+			removeFromFrontier(fromId, neighbour);
+		}
+		if (toId != -1 && neighbourCounts[toId * numSlots + neighbour]++ == 0 && ownerIds[neighbour] != toId) {
+			addToFrontier(toId, neighbour);
+		}
+	}
+
+	if (toId != -1) {
+		removeFromFrontier(toId, slot);
+	}
+	if (fromId != -1 && neighbourCounts[fromId * numSlots + slot] > 0) {
+		addToFrontier(fromId, slot);
+	}
+}
+
+void TerritoryState::addToFrontier(int id, int slot) {
+	int& position = frontierPositions[id * ownerIds.size() + slot];
+
+	if (position == -1) {
+		position = (int)frontiers[id].size();
+		frontiers[id].push_back(slot);
+	}
+}
+
+// The last slot of the frontier takes the place of the one removed
+void TerritoryState::removeFromFrontier(int id, int slot) {
+	int numSlots = (int)ownerIds.size();
+	int position = frontierPositions[id * numSlots + slot];
+
+	if (position == -1) {
+		return;
+	}
+
+	vector<int>& frontier = frontiers[id];
+	int last = frontier.back();
+	frontier[position] = last;
+	frontierPositions[id * numSlots + last] = position;
+	frontier.pop_back();
+	frontierPositions[id * numSlots + slot] = -1;
+}
+
+const vector<int>& TerritoryState::getFrontier(Player* player) {
+	static const vector<int> none;
+	int id = findPlayerId(player);
+	return id == -1 || adjacency == nullptr ? none : frontiers[id];
+}
+
+int TerritoryState::getContinentBonus(Player* player) {
+	int id = findPlayerId(player);
+	return id == -1 ? 0 : continentBonus[id];
+}
+
+bool TerritoryState::ownsContinent(Player* player, int continent) {
+	int id = findPlayerId(player);
+	int numContinents = (int)continentSizes.size();
+
+	if (id == -1 || continent < 0 || continent >= numContinents || continentSizes[continent] == 0) {
+		return false;
+	}
+
+	return continentCounts[id * numContinents + continent] == continentSizes[continent];
+}
+
+int TerritoryState::getArmies(int slot) {
+	return armies[slot];
+}
+
+void TerritoryState::setArmies(int slot, int numArmies) {
+	if (armies[slot] != numArmies) {
+		armies[slot] = numArmies;
+		epoch++;
+	}
+}
+
+int TerritoryState::findPlayerId(Player* player) {
+	if (player == nullptr) {
+		return -1;
+	}
+
+	// There are only a handful of players in a game, so a short scan is enough here
+	for (int id = 0; id < (int)players.size(); id++) {
+		if (players[id] == player) {
+			return id;
+		}
+	}
+	return -1;
+}
+
+int TerritoryState::registerPlayer(Player* player) {
+	int id = findPlayerId(player);
+	if (player == nullptr || id != -1) {
+		return id;
+	}
+
+	players.push_back(player);
+	continentCounts.resize(players.size() * continentSizes.size(), 0);
+	continentBonus.resize(players.size(), 0);
+	ownedCounts.push_back(0);
+	eventPending.push_back(false);
+	if (adjacency != nullptr) {
+		neighbourCounts.resize(players.size() * ownerIds.size(), 0);
+		frontierPositions.resize(players.size() * ownerIds.size(), -1);
+		frontiers.emplace_back();
+	}
+	return (int)players.size() - 1;
+}
+
+Player* TerritoryState::getPlayer(int id) {
+	if (id < 0 || id >= (int)players.size()) {
+		return nullptr;
+	}
+
+	return players[id];
+}
+
+int TerritoryState::countOwnedBy(Player* player) {
+	int id = findPlayerId(player);
+	return id == -1 ? 0 : ownedCounts[id];
+}
+
+int TerritoryState::armiesOwnedBy(Player* player) {
+	int id = findPlayerId(player);
+	int total = 0;
+	if (id == -1) {
+		return 0;
+	}
+
+	for (int slot = 0; slot < (int)ownerIds.size(); slot++) {
+		if (ownerIds[slot] == id) {
+			total += armies[slot];
+		}
+	}
+
+	return total;
+}
+
+const vector<int>& TerritoryState::getOwnerIds() {
+	return ownerIds;
+}
+
+const vector<int>& TerritoryState::getArmyCounts() {
+	return armies;
+}
+
+uint64_t TerritoryState::getEpoch() const {
+	return epoch;
+}
+
 // **************************************
 // TERRITORY IMPLEMENTATION
 // **************************************
@@ -87,6 +367,9 @@ Territory::Territory(const Territory &t) {
 	this->numberOfArmies = t.numberOfArmies;
 	this->countryIndex = t.countryIndex;
 	this->adjacentCountries = t.adjacentCountries;
+	this->neighbours = t.neighbours;
+	this->state = t.state;
+	this->slot = t.slot;
 	this->name = t.name;
 	this->parent = t.parent;
 	this->x = t.x;
@@ -139,6 +422,9 @@ Territory& Territory::operator=(const Territory& t) {
 	this->numberOfArmies = t.numberOfArmies;
 	this->countryIndex = t.countryIndex;
 	this->adjacentCountries = t.adjacentCountries;
+	this->neighbours = t.neighbours;
+	this->state = t.state;
+	this->slot = t.slot;
 	this->name = t.name;
 	this->parent = t.parent;
 	this->x = t.x;
@@ -154,11 +440,19 @@ int Territory::getIndex()
 
 Player* Territory::getOwner()
 {
+	if (this->state != nullptr) {
+		return this->state->getOwner(this->slot);
+	}
+
 	return this->owner;
 }
 
 int Territory::getNumberOfArmies()
 {
+	if (this->state != nullptr) {
+		return this->state->getArmies(this->slot);
+	}
+
 	return this->numberOfArmies;
 }
 
@@ -172,10 +466,9 @@ ostream& operator<<(ostream& out, const Territory& t) {
 	return out;
 }
 
-bool& operator==(const Territory& lhs, const Territory& rhs)
+bool operator==(const Territory& lhs, const Territory& rhs)
 {
-	bool toReturn = lhs.countryIndex == rhs.countryIndex;
-	return toReturn;
+	return lhs.countryIndex == rhs.countryIndex;
 }
 
 
@@ -184,9 +477,14 @@ int Territory::getContinent()
 	return this->parent;
 }
 
-vector<Territory*> Territory::getAdjacentTerritories()
+TerritorySpan Territory::getAdjacentTerritories()
 {
-	return this->adjacentCountries;
+	// Territories that belong to a map read straight from the map's adjacency table
+	if (this->neighbours.begin() != nullptr) {
+		return this->neighbours;
+	}
+
+	return TerritorySpan(this->adjacentCountries.data(), this->adjacentCountries.data() + this->adjacentCountries.size());
 }
 
 int Territory::getX()
@@ -200,11 +498,21 @@ int Territory::getY()
 }
 
 void Territory::setOwner(Player* player) {
+	if (this->state != nullptr) {
+		this->state->setOwner(this->slot, player);
+		return;
+	}
+
 	this->owner = player;
 }
 
 void Territory::setNumberOfArmies(int numArmies)
 {
+	if (this->state != nullptr) {
+		this->state->setArmies(this->slot, numArmies);
+		return;
+	}
+
 	this->numberOfArmies = numArmies;
 }
 
@@ -216,6 +524,7 @@ void Territory::setName(string newName)
 void Territory::setAdjacentTerritories(vector<Territory*> territories)
 {
 	this->adjacentCountries = territories;
+	this->neighbours = TerritorySpan();
 }
 
 void Territory::setX(int newX)
@@ -231,12 +540,13 @@ void Territory::setY(int newY)
 void Territory::addAdjacentCountry(Territory* territory)
 {
 	this->adjacentCountries.push_back(territory);
+	this->neighbours = TerritorySpan();
 }
 
 // checks adjacency with passed territory
 bool Territory::isAdjacent(Territory* territory)
 {
-	for (auto t : getAdjacentTerritories())
+	for (Territory* t : getAdjacentTerritories())
 	{
 		if (t == territory)
 		{
@@ -258,31 +568,336 @@ const string InvalidMapException::error() const throw() {
 	return " ";
 }
 
+// **************************************
+// MAP VALIDATION REPORT IMPLEMENTATION
+// **************************************
+
+bool MapValidationReport::isValid() const {
+	return issues.empty();
+}
+
+int MapValidationReport::count(InvalidMapException::MAP_ERRORS error) const {
+	int total = 0;
+
+	for (const MapValidationIssue& issue : issues) {
+		if (issue.error == error) {
+			total++;
+		}
+	}
+
+	return total;
+}
+
+// **************************************
+// MAP TOPOLOGY IMPLEMENTATION
+// **************************************
+
+MapTopology::MapTopology() {
+	buildTables();
+}
+
+MapTopology::MapTopology(const vector<Continent*>& continents, const vector<Territory*>& territories, vector<tuple<int, int>> borders) {
+	this->continents.reserve(continents.size());
+	for (Continent* c : continents) {
+		this->continents.push_back(*c);
+	}
+
+	this->territories.reserve(territories.size());
+	for (Territory* t : territories) {
+		this->territories.push_back({ t->getIndex(), t->getName(), t->getContinent(), t->getX(), t->getY() });
+	}
+
+	this->borders = move(borders);
+	buildTables();
+}
+
+int MapTopology::size() const
+{
+	return (int)territories.size();
+}
+
+const vector<int>& MapTopology::getAdjacencyOffsets() const
+{
+	return adjacencyOffsets;
+}
+
+const vector<int>& MapTopology::getAdjacency() const
+{
+	return adjacency;
+}
+
+const vector<int>& MapTopology::getContinentOffsets() const
+{
+	return continentOffsets;
+}
+
+const vector<int>& MapTopology::getContinentMembers() const
+{
+	return continentMembers;
+}
+
+const vector<int>& MapTopology::getContinentArmies() const
+{
+	return continentArmies;
+}
+
+int MapTopology::getPosition(int index) const
+{
+	if (index < 0 || index >= (int)territoryPosition.size()) {
+		return -1;
+	}
+
+	return territoryPosition[index];
+}
+
+const MapValidationReport& MapTopology::getValidationReport() const
+{
+	call_once(checked, [this]() {
+		if (!knownValid) {
+			report = checkConnectivity();
+		}
+	});
+	return report;
+}
+
+/**
+	* FUNCTION: buildTables
+	*
+	* Builds the topology's lookup table (territory index -> position) and packs the borders into a compressed sparse row adjacency table: all
+	* neighbours are stored back to back in 'adjacency', and 'adjacencyOffsets' marks where each territory's run starts. Borders that refer to unknown
+	* territories are ignored. The territories are grouped by continent in the same way, so continent queries return a view instead of scanning all territories.
+	* Every entry of these tables is a position, so each game's Map can lay its own territory pointers out in the same way (see Map::bindTopology).
+	*
+	*/
+void MapTopology::buildTables()
+{
+	int numCountries = (int)territories.size();
+
+	int maxIndex = -1;
+	for (const TerritoryInfo& t : territories) {
+		maxIndex = max(maxIndex, t.index);
+	}
+
+	territoryPosition.assign(maxIndex + 1, -1);
+	for (int i = 0; i < numCountries; i++) {
+		if (territories[i].index >= 0) {
+			territoryPosition[territories[i].index] = i;
+		}
+	}
+
+	// Count each territory's neighbours, then turn the counts into offsets
+	adjacencyOffsets.assign(numCountries + 1, 0);
+	for (const tuple<int, int>& border : borders) {
+		int from = getPosition(get<0>(border));
+		int to = getPosition(get<1>(border));
+
+		if (from != -1 && to != -1) {
+			adjacencyOffsets[from + 1]++;
+		}
+	}
+
+	for (int i = 0; i < numCountries; i++) {
+		adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+	}
+
+	// Place each neighbour in its territory's run, keeping the order of the map file
+	adjacency.assign(adjacencyOffsets[numCountries], -1);
+	vector<int> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (const tuple<int, int>& border : borders) {
+		int from = getPosition(get<0>(border));
+		int to = getPosition(get<1>(border));
+
+		if (from != -1 && to != -1) {
+			adjacency[cursor[from]++] = to;
+		}
+	}
+
+	// Continent of every territory, by position in 'continents'
+	continentPosition.clear();
+	continentArmies.assign(continents.size(), 0);
+	for (int c = 0; c < (int)continents.size(); c++) {
+		int continentIndex = continents[c].getIndex();
+
+		if (continentIndex >= (int)continentPosition.size()) {
+			continentPosition.resize(continentIndex + 1, -1);
+		}
+		continentPosition[continentIndex] = c;
+		continentArmies[c] = continents[c].getArmies();
+	}
+
+	territoryContinent.assign(numCountries, -1);
+	for (int i = 0; i < numCountries; i++) {
+		int parent = territories[i].continent;
+
+		if (parent >= 0 && parent < (int)continentPosition.size()) {
+			territoryContinent[i] = continentPosition[parent];
+		}
+	}
+
+	// Group the territories by continent, the same way the borders are grouped by territory
+	continentOffsets.assign(continents.size() + 1, 0);
+	for (int c : territoryContinent) {
+		if (c != -1) {
+			continentOffsets[c + 1]++;
+		}
+	}
+
+	for (int c = 0; c < (int)continents.size(); c++) {
+		continentOffsets[c + 1] += continentOffsets[c];
+	}
+
+	continentMembers.assign(continentOffsets[continents.size()], -1);
+	vector<int> memberCursor(continentOffsets.begin(), continentOffsets.end() - 1);
+	for (int i = 0; i < numCountries; i++) {
+		if (territoryContinent[i] != -1) {
+			continentMembers[memberCursor[territoryContinent[i]]++] = i;
+		}
+	}
+}
+
+/**
+	* FUNCTION: checkConnectivity
+	*
+	* Verifies that the whole map, as well as each continent's subgraph, is connected, and reports every problem found rather than stopping at the first one.
+	*
+	* Territories are addressed by their position and their neighbours are read from the adjacency table (see buildTables), so each
+	* check is a plain breadth-first search that visits every node and every border at most once. The whole map is searched starting
+	* from the first territory; any territory that cannot be reached is reported as an ISOLATED_NODE. Each continent is then searched starting from its first member,
+	* following only borders that stay inside that continent; a continent with an unreachable member is reported as a DISCONNECTED_SUBGRAPH, and a continent without
+	* any members is reported as an EMPTY_CONTINENT. The cost of the whole check is O(V + E).
+	*
+	* @returns report <MapValidationReport>: Every problem found. The map is valid if the report is empty.
+	*
+	*/
+MapValidationReport MapTopology::checkConnectivity() const
+{
+	MapValidationReport report;
+	int numCountries = (int)territories.size();
+
+	if (numCountries == 0) {
+		return report;
+	}
+
+	// 1) The map is a connected graph: every node must be reachable from the first one
+	vector<bool> reached(numCountries, false);
+	vector<int> queue;
+	queue.reserve(numCountries);
+
+	queue.push_back(0);
+	reached[0] = true;
+
+	for (size_t head = 0; head < queue.size(); head++) {
+		int node = queue[head];
+
+		for (int e = adjacencyOffsets[node]; e < adjacencyOffsets[node + 1]; e++) {
+			int next = adjacency[e];
+
+			if (!reached[next]) {
+				reached[next] = true;
+				queue.push_back(next);
+			}
+		}
+	}
+
+	for (int i = 0; i < numCountries; i++) {
+		if (!reached[i]) {
+			report.issues.push_back({ InvalidMapException::ISOLATED_NODE, territories[i].index });
+		}
+	}
+
+	// 2) Each continent is a connected subgraph: every member must be reachable from the first member without leaving the continent
+	// A node belongs to exactly one continent, so a single marker array serves every continent search
+	vector<bool> visited(numCountries, false);
+	for (int c = 0; c < (int)continents.size(); c++) {
+		int memberCount = continentOffsets[c + 1] - continentOffsets[c];
+
+		if (memberCount == 0) {
+			report.issues.push_back({ InvalidMapException::EMPTY_CONTINENT, continents[c].getIndex() });
+			continue;
+		}
+
+		int firstMember = continentMembers[continentOffsets[c]];
+		queue.clear();
+		queue.push_back(firstMember);
+		visited[firstMember] = true;
+
+		for (size_t head = 0; head < queue.size(); head++) {
+			int node = queue[head];
+
+			for (int e = adjacencyOffsets[node]; e < adjacencyOffsets[node + 1]; e++) {
+				int next = adjacency[e];
+
+				if (!visited[next] && territoryContinent[next] == c) {
+					visited[next] = true;
+					queue.push_back(next);
+				}
+			}
+		}
+
+		if ((int)queue.size() != memberCount) {
+			report.issues.push_back({ InvalidMapException::DISCONNECTED_SUBGRAPH, continents[c].getIndex() });
+		}
+	}
+
+	return report;
+}
+
 // **************************************
 // MAP IMPLEMENTATION
 // **************************************
 
-Map::Map() {}
+Map::Map() : topology(make_shared<const MapTopology>()), valid(false) {}
 
+// The territories are shared with 'm' (shallow copy), so they keep pointing at the adjacency table and the state of 'm'
 Map::Map(const Map& m) {
+	this->topology = m.topology;
 	this->continents = m.continents;
 	this->countries = m.countries;
-	this->borders = m.borders;
 	this->valid = m.valid;
+	this->sourceFile = m.sourceFile;
+	this->sourceHash = m.sourceHash;
+	this->adjacency = m.adjacency;
+	this->continentMembers = m.continentMembers;
 }
 
 Map::Map(vector<Continent*> continents, vector<Territory*> countries, vector<tuple<int, int>> borders) {
-	this->continents = continents;
-	this->countries = countries;
-	this->borders = borders;
+	this->continents = move(continents);
+	this->countries = move(countries);
+	this->valid = false;
+	buildTables(move(borders));
+}
+
+Map::Map(shared_ptr<const MapTopology> topology) {
+	this->topology = move(topology);
 	this->valid = false;
+
+	// Every object of the game in one block each (reserved up front, so the pointers to them stay put)
+	continentBlock.reserve(this->topology->continents.size());
+	continents.reserve(this->topology->continents.size());
+	for (const Continent& c : this->topology->continents) {
+		continentBlock.push_back(c);
+		continents.push_back(&continentBlock.back());
+	}
+
+	territoryBlock.reserve(this->topology->territories.size());
+	countries.reserve(this->topology->territories.size());
+	for (const MapTopology::TerritoryInfo& t : this->topology->territories) {
+		territoryBlock.emplace_back(t.index, t.name, t.continent, t.x, t.y);
+		countries.push_back(&territoryBlock.back());
+	}
+
+	bindTopology();
 }
 
 Map& Map::operator=(const Map& m) {
+	this->topology = m.topology;
 	this->continents = m.continents;
 	this->countries = m.countries;
-	this->borders = m.borders;
 	this->valid = m.valid;
+	this->sourceFile = m.sourceFile;
+	this->sourceHash = m.sourceHash;
+	this->adjacency = m.adjacency;
+	this->continentMembers = m.continentMembers;
 
 	return *this;
 }
@@ -304,7 +919,7 @@ vector<Territory*> Map::getTerritories()
 
 vector<tuple<int, int>> Map::getBorders()
 {
-	return this->borders;
+	return topology->borders;
 }
 
 bool Map::isValid()
@@ -312,113 +927,184 @@ bool Map::isValid()
 	return valid;
 }
 
+string Map::getSourceFile()
+{
+	return sourceFile;
+}
+
+shared_ptr<const MapTopology> Map::getTopology()
+{
+	return topology;
+}
+
+Map* Map::clone()
+{
+	Map* copy = new Map(topology);
+	copy->valid = valid;
+	copy->sourceFile = sourceFile;
+	copy->sourceHash = sourceHash;
+
+	// The copy's territories keep pointing at the copy's own state
+	copy->state = state;
+	return copy;
+}
+
 vector<tuple<int, int>> Map::getBordersByCountry(Territory country)
 {
 	vector<tuple<int, int>> bordersByCountry;
+	int position = getPosition(country.getIndex());
 
-	for (tuple<int, int> border : this->borders) {
-		if (get<0>(border) == country.getIndex()) {
-			bordersByCountry.push_back(border);
-		}
+	if (position == -1) {
+		return bordersByCountry;
+	}
+
+	const vector<int>& offsets = topology->adjacencyOffsets;
+	bordersByCountry.reserve(offsets[position + 1] - offsets[position]);
+	for (int e = offsets[position]; e < offsets[position + 1]; e++) {
+		bordersByCountry.push_back({ country.getIndex(), adjacency[e]->getIndex() });
 	}
 
 	return bordersByCountry;
 }
 
-vector<Territory*> Map::getTerritoriesByContinent(int continent)
+TerritorySpan Map::getTerritoriesByContinent(int continent)
 {
-	vector<Territory*> continentCountries;
-		
-	for (Territory* t : this->countries) {
-		if (t->getContinent() == continent) {
-			continentCountries.push_back(t);
-		}
+	const vector<int>& continentPosition = topology->continentPosition;
+	if (continent < 0 || continent >= (int)continentPosition.size() || continentPosition[continent] == -1) {
+		return TerritorySpan();
 	}
 
-	return continentCountries;
+	int c = continentPosition[continent];
+	const vector<int>& offsets = topology->continentOffsets;
+	return TerritorySpan(continentMembers.data() + offsets[c], continentMembers.data() + offsets[c + 1]);
 }
 
 void Map::setContinents(vector<Continent*> continents)
 {
 	this->continents = continents;
+	buildTables(topology->borders);
 }
 
 void Map::setTerritories(vector<Territory*> territories)
 {
 	this->countries = territories;
+	buildTables(topology->borders);
 }
 
 void Map::setBorders(vector<tuple<int, int>> borders)
 {
-	this->borders = borders;
+	buildTables(move(borders));
 }
 
 void Map::addContinent(Continent* continent)
 {
 	this->continents.push_back(continent);
+	buildTables(topology->borders);
 }
 
 void Map::addTerritory(Territory* territory)
 {
 	this->countries.push_back(territory);
+	buildTables(topology->borders);
 }
 
 void Map::addBorder(tuple<int, int> border)
 {
-	this->borders.push_back(border);
+	vector<tuple<int, int>> borders = topology->borders;
+	borders.push_back(border);
+	buildTables(move(borders));
 }
 
 /**
-	* FUNCTION: borderExists
+	* FUNCTION: buildTables
 	*
-	* @param toCheck <vector<Territory*>>: A collection of nodes to be verified as being able to connect to the 'destination' node.
-	* @param destination <Territory>: The node to connect to.
-	* @param checked <vector<Territory>>: A collection of nodes which marks nodes that have already been traversed.
-	* 
-	* 
-	* This function tests each node in toCheck to see if it can connect to the 'destination' node. If a node can connect to 'destination', then the function returns true and exits. Otherwise,
-	* it is marked as traversed by being added to the 'checked' vector and then its adjacent nodes are verified. If all nodes in toCheck, as well as their adjacent nodes, fail to connect to
-	* 'destination', then the function returns false.
-	* 
-	* @returns boolean: True if one of the nodes in 'toCheck' can connect to 'destination', false otherwise.
+	* Builds a new topology from the map's continents and territories and the given borders, and binds the map to it. The previous topology is only
+	* released, never changed, since other games may still be using it.
 	*
 	*/
+void Map::buildTables(vector<tuple<int, int>> borders)
+{
+	topology = make_shared<const MapTopology>(continents, countries, move(borders));
+	valid = false;
+	// The map no longer matches the file it was loaded from, if any
+	sourceFile.clear();
+	sourceHash = 0;
+	bindTopology();
+}
 
-bool Map::borderExists(vector<Territory*> toCheck, Territory destination, vector<Territory> checked)
+/**
+	* FUNCTION: bindTopology
+	*
+	* Lays the map's own territory pointers out like the topology's position tables, and points every territory at its run of neighbours, so walking a territory's
+	* neighbours never allocates. Every territory's owner and army count are also moved into the map's state, in the same order as 'countries', and the state is
+	* told which continent each territory belongs to so that it can keep the continent bonuses up to date.
+	*
+	*/
+void Map::bindTopology()
 {
-	// If there are no more nodes to check, we must assume that no links to the destination exist.
-	if (toCheck.size() == 0) {
-		return false;
+	int numCountries = (int)countries.size();
+	const vector<int>& offsets = topology->adjacencyOffsets;
+
+	adjacency.resize(topology->adjacency.size());
+	for (size_t e = 0; e < adjacency.size(); e++) {
+		adjacency[e] = countries[topology->adjacency[e]];
 	}
 
-	vector<Territory*> neighbours;
+	for (int i = 0; i < numCountries; i++) {
+		countries[i]->neighbours = TerritorySpan(adjacency.data() + offsets[i], adjacency.data() + offsets[i + 1]);
+	}
 
-	// For each node in toCheck, check to see if it shares a border with the destination node
-	for (Territory* t : toCheck) {
-		// Only proceed if we have not checked this node already
-		if (!territoryExists(checked, *t)) {
-			for (tuple<int, int> border : this->getBordersByCountry(*t)) {
-				if (get<1>(border) == destination.getIndex()) {
-					// A border links the two nodes, hence they are connected.
-					return true;
-				}
+	continentMembers.resize(topology->continentMembers.size());
+	for (size_t m = 0; m < continentMembers.size(); m++) {
+		continentMembers[m] = countries[topology->continentMembers[m]];
+	}
 
-				else {
-					// Cross this node off our list of nodes to check
-					checked.push_back(*t);
+	// Move every territory's owner and army count into the state (read them all first, since some territories may already live in it)
+	vector<Player*> owners(numCountries);
+	vector<int> armies(numCountries);
+	for (int i = 0; i < numCountries; i++) {
+		owners[i] = countries[i]->getOwner();
+		armies[i] = countries[i]->getNumberOfArmies();
+	}
 
-					// Add this node's neighbours to our list of nodes to check
-					for (Territory* tr : t->getAdjacentTerritories()) {
-						if (!territoryExists(checked, *tr)) { // If it hasn't been checked already
-							neighbours.push_back(tr);
-						}
-					}
-				}
-			}
-		}
+	state = TerritoryState();
+	state.resize(numCountries);
+	state.setContinents(topology->territoryContinent, topology->continentArmies);
+	state.setAdjacency(&topology->adjacencyOffsets, &topology->adjacency);
+	for (int i = 0; i < numCountries; i++) {
+		state.setOwner(i, owners[i]);
+		state.setArmies(i, armies[i]);
+		countries[i]->state = &state;
+		countries[i]->slot = i;
 	}
+}
 
-	return borderExists(neighbours, destination, checked);
+int Map::getPosition(int index)
+{
+	return topology->getPosition(index);
+}
+
+TerritoryState* Map::getState()
+{
+	return &state;
+}
+
+TerritorySpan Map::getNeighbours(Territory* territory)
+{
+	int position = getPosition(territory->getIndex());
+
+	if (position == -1 || countries[position] != territory) {
+		return TerritorySpan();
+	}
+
+	const vector<int>& offsets = topology->adjacencyOffsets;
+	return TerritorySpan(adjacency.data() + offsets[position], adjacency.data() + offsets[position + 1]);
+}
+
+// The check itself is done once per topology, see MapTopology::checkConnectivity
+MapValidationReport Map::checkConnectivity()
+{
+	return topology->getValidationReport();
 }
 
 /**
@@ -429,102 +1115,52 @@ bool Map::borderExists(vector<Territory*> toCheck, Territory destination, vector
 	* 2) Each continent of the map is connected.
 	*
 	* Due to the format of the map files, the third requirement (that each territory belongs to a sole continent) is enforced, hence there is no need to verify this.
-	* The function makes use of the helper method borderExists (see above function) to verify that the map is connected. It assumes that a map is connected if we can reach all nodes from a given
-	* node, so if borderExists() returns true for each node, the map is a connected graph.
-	*
-	*
-	* For the second requirement, the map's territories are subdivided into smaller graphs based on the continent they belong to. Then, for each subgraph, the process for 1) is applied. Unless
-	* one of the borderExists() calls return false, all continents are connected subgraphs.
-	*
+	* The checks themselves are done by checkConnectivity (see above function); this function reports the problems it found and marks the map as valid only if there
+	* were none. It is up to the caller to decide what to do with an invalid map (see isValid()). The checks only run once per topology, so validating a map that
+	* shares its topology with another game (or that came from a compiled map cache) only reports the known result.
 	*
 	*/
 void Map::validate() {
-	// This function takes a while to complete, so let the user know that things are moving along.
-	cout << "Validating map..." << endl;
+	validate(Output::standard());
+}
+
+void Map::validate(Output& output) {
+	GAME_OUTPUT(output, Verbosity::Narrative) << "Validating map..." << endl;
+	valid = false;
 
-	if (countries.size() < 1 || continents.size() < 1 || borders.size() < 1) {
-		cout << "Map cannot be empty, please ensure that the map file provided actually exists." << endl;
+	if (countries.size() < 1 || continents.size() < 1 || topology->borders.size() < 1) {
+		GAME_OUTPUT(output, Verbosity::Summary) << "Map cannot be empty, please ensure that the map file provided actually exists." << endl;
 		return;
 	}
 
-	vector<Territory> checked;
-
-	// Check if the map is a connected graph (invalid if there exists a node that is not connected to anything)
-	Territory* node1 = this->countries.at(0);
-
-	for (Territory* t : this->getTerritories()) {
-		// We want to check all other nodes
-		if (node1 != t) {
-			cout << "Checking: " << node1->getIndex() << ", " << t->getIndex() << endl;
-			vector<Territory*> tmp;
-			tmp.push_back(node1);
-			if (!borderExists(tmp, *t, checked)) {
-				// Throw Invalid Map Exception - Isolated Node
-				cout << "Map is invalid: Map cannot contain an isolated node." << endl;
-				exit(EXIT_SUCCESS);
-			}
-
-			else {
-				cout << "Link established!" << endl;
-			}
+	const MapValidationReport& report = topology->getValidationReport();
+
+	for (const MapValidationIssue& issue : report.issues) {
+		switch (issue.error) {
+		case InvalidMapException::ISOLATED_NODE:
+			GAME_OUTPUT(output, Verbosity::Summary) << "Map is invalid: Map cannot contain an isolated node (territory " << issue.index << " cannot be reached)." << endl;
+			break;
+		case InvalidMapException::DISCONNECTED_SUBGRAPH:
+			GAME_OUTPUT(output, Verbosity::Summary) << "Map is invalid: All nodes within a continent must be connected (continent " << issue.index << " is not)." << endl;
+			break;
+		case InvalidMapException::EMPTY_CONTINENT:
+			GAME_OUTPUT(output, Verbosity::Summary) << "Map is invalid: All continents must have at least one node (continent " << issue.index << " is empty)." << endl;
+			break;
 		}
 	}
-		
-	// At this point, we can confirm that the map is a connected graph!
-	// Check if continents are connected subgraphs (return a group of territories by continent index)
-		
-	// Loop through all defined continents
-	for (Continent* c : this->getContinents()) {
-		cout << "Validating continent " << c->getIndex() << endl;
-		vector<Territory*> continentCountries = this->getTerritoriesByContinent(c->getIndex());
-
-		if (continentCountries.size() == 0) {
-			// Throw exception, as there is a continent defined with no countries belonging to it
-			cout << "Map is invalid: All continents must have at least one node." << endl;
-			exit(EXIT_SUCCESS);
-
-		}
-			
-		else if (continentCountries.size() > 1) {
-			Territory* startNode = continentCountries.at(0);
-			vector<Territory*> tmp;
-			tmp.push_back(startNode);
-
-			for (Territory* t : continentCountries) {
-				vector<Territory> checked;
-				if (!borderExists(tmp, *t, checked)) {
-					cout << "Map is invalid: All nodes within a continent must be connected." << endl;
-					cout << "Territories that are not connected: " << startNode->getName() << " and " << t->getName() << endl;
-					exit(EXIT_SUCCESS);
-				}
-			}
-		}
-			
-		else {
-			// If there is only one country in a continent, it technically is a connected subgraph
-		}
+
+	if (!report.isValid()) {
+		return;
 	}
 
-	// If the function exits without throwing an exception, we can say that the map is valid!
-	cout << "This map is valid!" << endl;
+	// If the function exits without finding any problem, we can say that the map is valid!
+	GAME_OUTPUT(output, Verbosity::Narrative) << "This map is valid!" << endl;
 	valid = true;
 }
 
 int Map::calculateContinentBonus(Player* player)
 {
-	int continentBonus = 0;
-	for (Continent* c : getContinents()) {
-		bool pHasAllT = true;
-		for (Territory* t : getTerritoriesByContinent(c->getIndex())) {
-			if (!player->ownsTerritory(t)) {
-				pHasAllT = false;
-			}
-		}
-		if (pHasAllT) {
-			continentBonus = continentBonus + c->getArmies();
-		}
-	}
-	return continentBonus;
+	return state.getContinentBonus(player);
 }
 
 bool Map::territoryExists(vector<Territory> collection, Territory toFind)
@@ -538,15 +1174,26 @@ bool Map::territoryExists(vector<Territory> collection, Territory toFind)
 	return false;
 }
 
+// True if the object is one of the elements of the block
+template <typename T>
+static bool inBlock(const vector<T>& block, const T* object) {
+	return !block.empty() && object >= block.data() && object < block.data() + block.size();
+}
+
+// Objects created in the map's blocks go with the blocks, the others were handed to the map one by one
 Map::~Map() {
 	for (int i = 0; i < continents.size(); i++) {
-		delete continents.at(i);
+		if (!inBlock(continentBlock, continents.at(i))) {
+			delete continents.at(i);
+		}
 		continents.at(i) = NULL;
 	}
 	continents.clear();
 
 	for (int j = 0; j < countries.size(); j++) {
-		delete countries.at(j);
+		if (!inBlock(territoryBlock, countries.at(j))) {
+			delete countries.at(j);
+		}
 		countries.at(j) = NULL;
 	}
 	countries.clear();
@@ -554,157 +1201,584 @@ Map::~Map() {
 
 //Method for Player class
 Territory* Map::getTerritoryByIndex(int index) {
-    for(auto it: getTerritories()){
-        if(it->getIndex() == index){
-            return it;
-        }
-    }
-    return nullptr;
+	int position = getPosition(index);
+
+	if (position == -1) {
+		return nullptr;
+	}
+
+	return countries[position];
+}
+
+Territory* Map::getTerritoryAt(int position) {
+	return countries[position];
+}
+
+vector<Territory*> Map::getFrontier(Player* player)
+{
+	vector<int> slots = state.getFrontier(player);
+	sort(slots.begin(), slots.end());
+
+	vector<Territory*> frontier(slots.size());
+	for (size_t i = 0; i < slots.size(); i++) {
+		frontier[i] = countries[slots[i]];
+	}
+	return frontier;
 }
 
 // **************************************
 // MAPLOADER IMPLEMENTATION
 // **************************************
 
+/**
+	* Read-only view of the whole contents of a file.
+	*
+	* The file is memory-mapped where the platform allows it, so the loader reads the operating system's copy of the file directly and never copies it. Elsewhere,
+	* the file is read into memory in one go.
+	*/
+class MappedFile
+{
+private:
+	const char* data = nullptr;
+	size_t size = 0;
+	bool open = false;
+#ifdef _WIN32
+	string contentsCopy;
+#endif
+
+public:
+	explicit MappedFile(const string& fileName) {
+#ifdef _WIN32
+		ifstream file(fileName, ifstream::binary);
+		if (!file) {
+			return;
+		}
+		contentsCopy.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+		data = contentsCopy.data();
+		size = contentsCopy.size();
+		open = true;
+#else
+		int fd = ::open(fileName.c_str(), O_RDONLY);
+		if (fd == -1) {
+			return;
+		}
+		struct stat info;
+		if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+			size = (size_t)info.st_size;
+			if (size == 0) {
+				open = true;
+			}
+			else {
+				void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (mapping != MAP_FAILED) {
+					madvise(mapping, size, MADV_SEQUENTIAL);
+					data = (const char*)mapping;
+					open = true;
+				}
+			}
+		}
+		::close(fd);
+#endif
+	}
+
+	~MappedFile() {
+#ifndef _WIN32
+		if (data != nullptr) {
+			munmap((void*)data, size);
+		}
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool isOpen() const { return open; }
+	string_view contents() const { return string_view(data, size); }
+};
+
+/**
+	* Walks over the lines of a map file without copying them. Line breaks may be "\n" or "\r\n".
+	*/
+class MapLineReader
+{
+private:
+	string_view rest;
+	int lineNumber = 0;
+
+public:
+	explicit MapLineReader(string_view contents) : rest(contents) {}
+
+	// Reads the next line into 'line', returns false at the end of the file
+	bool next(string_view& line) {
+		if (rest.empty()) {
+			return false;
+		}
+		size_t end = rest.find('\n');
+		line = rest.substr(0, end);
+		rest = end == string_view::npos ? string_view() : rest.substr(end + 1);
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		lineNumber++;
+		return true;
+	}
+
+	// Number of the last line read, starting at 1
+	int getLineNumber() const { return lineNumber; }
+};
+
+static bool isSpace(char c) {
+	return c == ' ' || c == '\t';
+}
+
+// Takes the next space or tab separated token off the front of 'line', returns false if there is none
+static bool nextToken(string_view& line, string_view& token) {
+	const char* p = line.data();
+	const char* end = p + line.size();
+	while (p != end && isSpace(*p)) {
+		p++;
+	}
+	const char* start = p;
+	while (p != end && !isSpace(*p)) {
+		p++;
+	}
+	token = string_view(start, p - start);
+	line = string_view(p, end - p);
+	return p != start;
+}
+
+// Parses a whole token as an int, returns false if it is not one
+static bool parseInt(string_view token, int& value) {
+	const char* last = token.data() + token.size();
+	from_chars_result result = from_chars(token.data(), last, value);
+	return result.ec == errc() && result.ptr == last;
+}
+
+// Sections of a map file that the loader reads, every other section ([files], ...) is skipped
+enum class MapSection { Other, Continents, Countries, Borders };
+
+// Works out which section a line starts, or returns false if the line is not a section header
+static bool sectionHeader(string_view line, MapSection& section) {
+	if (line.empty() || line.front() != '[') {
+		return false;
+	}
+	if (line == "[continents]") section = MapSection::Continents;
+	else if (line == "[countries]") section = MapSection::Countries;
+	else if (line == "[borders]") section = MapSection::Borders;
+	else section = MapSection::Other;
+	return true;
+}
+
+// True for lines that hold nothing to read: blank lines end a section, and lines starting with ';' are comments
+static bool isBlank(string_view line) {
+	string_view token;
+	return !nextToken(line, token);
+}
+
+static bool isComment(string_view line) {
+	string_view token;
+	return nextToken(line, token) && token.front() == ';';
+}
+
+// Topology of every map file loaded so far, with the hash of the contents it was loaded from
+static mutex loadedTopologiesMutex;
+static unordered_map<string, pair<uint64_t, shared_ptr<const MapTopology>>> loadedTopologies;
+
+// 64-bit hash of a map file's contents, used to tell whether its compiled map cache is stale. FNV-1a, except that it takes in 8 bytes
+// at a time (with an extra shift to mix the high bits back down), so hashing even a large map costs little next to parsing it.
+static uint64_t hashContents(string_view contents) {
+	const uint64_t prime = 0x100000001B3ULL;
+	uint64_t hash = 0xCBF29CE484222325ULL ^ contents.size();
+	const char* p = contents.data();
+	size_t left = contents.size();
+
+	for (; left >= 8; p += 8, left -= 8) {
+		uint64_t word;
+		memcpy(&word, p, sizeof(word));
+		hash = (hash ^ word) * prime;
+		hash ^= hash >> 32;
+	}
+	for (; left > 0; p++, left--) {
+		hash = (hash ^ (unsigned char)*p) * prime;
+	}
+	return hash;
+}
+
 /**
 	* FUNCTION: createMapfromFile
 	* 
 	* @param mapFileName <string>: The path to the map file to be read.
 	*
-	* Upon recieving a path to a map file, this function opens the file and begins parsing the file for data which it can then use to create a map. The function begins
-	* by searching for a section header line (such as '[continents]', '[countries]' and '[borders]'). It then assumes every line that follows (until a blank line is read, in which case, 
-	* it looks for another header line.) contains relevant data to the section it is in and reads each line before storing the object created from the data in the line in its proper vector.
-	* Once all the vectors have been populated, a map is created using all of the vectors and returned upon exit.
+	* Loads a map, printing what is wrong with the file if it cannot be loaded. See createMapfromFile(string, string&).
 	*
-	*
-	* @returns m <Map*>: The map that has been created based on the data in the provided map file.
+	* @returns m <Map*>: The map that has been created based on the data in the provided map file, or NULL if the file could not be loaded.
 	* 
 	*/
 Map* MapLoader::createMapfromFile(string mapFileName) {
-	// Open the file
-	ifstream mapFile(mapFileName);
-	string currentLine;
-	string delimiter = " ";
-	int currentContinent = 0;
+	string error;
+	Map* m = createMapfromFile(mapFileName, error);
+
+	if (m == NULL) {
+		cout << error << endl;
+	}
+	return m;
+}
+
+/**
+	* FUNCTION: createMapfromFile
+	* 
+	* @param mapFileName <string>: The path to the map file to be read.
+	* @param error <string&>: Set to what is wrong with the file when it cannot be loaded, including the number of the line at fault.
+	*
+	* The file is memory-mapped. If the compiled map cache of the file (see saveCache) was made from these exact contents, the map is read from the
+	* cache instead and comes back already validated. Otherwise the file is read in two passes, without copying any line or number out of it. The first pass only counts the lines of the
+	* '[continents]' and '[countries]' sections and the neighbours listed in the '[borders]' section, so every vector can be given its final size up
+	* front. The second pass reads each line of those sections (until a blank line or another section header) and creates the continents, territories
+	* and borders, reading every number in place with from_chars. Once all the vectors have been populated, a map is created using all of the vectors.
+	*
+	* @returns m <Map*>: The map that has been created based on the data in the provided map file, or NULL if the file is missing or malformed.
+	* 
+	*/
+Map* MapLoader::createMapfromFile(string mapFileName, string& error) {
+	MappedFile mapFile(mapFileName);
+	if (!mapFile.isOpen()) {
+		error = "ERROR: Could not open the map file " + mapFileName;
+		return NULL;
+	}
+
+	uint64_t contentsHash = hashContents(mapFile.contents());
+	Map* m = NULL;
+
+	// A topology already loaded from these exact contents is shared, otherwise a compiled map cache of them skips parsing and validation
+	shared_ptr<const MapTopology> topology;
+	{
+		lock_guard<mutex> lock(loadedTopologiesMutex);
+		auto loaded = loadedTopologies.find(mapFileName);
+		if (loaded != loadedTopologies.end() && loaded->second.first == contentsHash) {
+			topology = loaded->second.second;
+		}
+	}
+	if (topology == nullptr) {
+		topology = loadCache(mapFileName, contentsHash);
+	}
+
+	if (topology != nullptr) {
+		m = new Map(topology);
+		m->valid = topology->knownValid;
+	}
+	else {
+		m = parseMap(mapFile.contents(), mapFileName, error);
+	}
+	if (m == NULL) {
+		return NULL;
+	}
+
+	m->sourceFile = mapFileName;
+	m->sourceHash = contentsHash;
+
+	lock_guard<mutex> lock(loadedTopologiesMutex);
+	loadedTopologies[mapFileName] = { contentsHash, m->topology };
+	return m;
+}
+
+// Second half of createMapfromFile(), see above
+Map* MapLoader::parseMap(string_view contents, const string& mapFileName, string& error) {
+	string_view line, token;
+	MapSection section = MapSection::Other;
+
+	// First pass: count what each section holds
+	size_t numContinents = 0, numCountries = 0, numBorders = 0;
+	MapLineReader counter(contents);
+	while (counter.next(line)) {
+		if (sectionHeader(line, section) || isComment(line)) {
+			continue;
+		}
+		if (isBlank(line)) {
+			section = MapSection::Other;
+		}
+		else if (section == MapSection::Continents) {
+			numContinents++;
+		}
+		else if (section == MapSection::Countries) {
+			numCountries++;
+		}
+		else if (section == MapSection::Borders) {
+			// Every token after the territory's own index is a neighbour
+			nextToken(line, token);
+			while (nextToken(line, token)) {
+				numBorders++;
+			}
+		}
+	}
 
 	// Vectors to store the data retrieved from the map file
 	vector<Continent*> tempContinents;
 	vector<Territory*> tempCountries;
 	vector<tuple<int, int>> tempBorders;
+	tempContinents.reserve(numContinents);
+	tempCountries.reserve(numCountries);
+	tempBorders.reserve(numBorders);
 
-	// Parse the file to create the map, use the headers to jump to different points in the file
-
-	// TODO: Add try-catch block
-	try {
-		while (getline(mapFile, currentLine)) {
-			if (currentLine == "[continents]") {
-
-				while (getline(mapFile, currentLine)) {
-					// An empty line marks the end of that section
-					if (currentLine == "") {
-						break;
-					}
+	MapLineReader reader(contents);
 
-					else {
-						// Get continent fields
-						currentContinent++;
-						string name = currentLine.substr(0, currentLine.find(delimiter));
-
-						int offset = name.length() + delimiter.length();
+	// Gives up on the file, reporting what is wrong with the current line
+	auto fail = [&](const string& problem) -> Map* {
+		error = "ERROR: " + mapFileName + ", line " + to_string(reader.getLineNumber()) + ": " + problem;
+		for (Continent* c : tempContinents) {
+			delete c;
+		}
+		for (Territory* t : tempCountries) {
+			delete t;
+		}
+		return NULL;
+	};
+
+	// Second pass: create the continents, territories and borders
+	section = MapSection::Other;
+	while (reader.next(line)) {
+		if (sectionHeader(line, section) || isComment(line)) {
+			continue;
+		}
+		if (isBlank(line)) {
+			// A blank line marks the end of a section
+			section = MapSection::Other;
+			continue;
+		}
 
-						string armyValue = currentLine.substr(offset, currentLine.find(delimiter, offset));
+		if (section == MapSection::Continents) {
+			// <name> <bonus armies> [colour]
+			string_view name;
+			int armies;
+			if (!nextToken(line, name) || !nextToken(line, token)) {
+				return fail("expected a continent as '<name> <bonus armies>'");
+			}
+			if (!parseInt(token, armies)) {
+				return fail("the bonus armies of continent " + string(name) + " are not a number: '" + string(token) + "'");
+			}
+			tempContinents.push_back(new Continent((int)tempContinents.size() + 1, string(name), armies));
+		}
 
-						Continent* c = new Continent(currentContinent, name, stoi(armyValue));
-						tempContinents.push_back(c);
-					}
+		else if (section == MapSection::Countries) {
+			// <index> <name> <continent> <x> <y>
+			string_view index, name, continent, x, y;
+			int fields[4];
+			if (!nextToken(line, index) || !nextToken(line, name) || !nextToken(line, continent) || !nextToken(line, x) || !nextToken(line, y)) {
+				return fail("expected a territory as '<index> <name> <continent> <x> <y>'");
+			}
+			string_view numbers[4] = { index, continent, x, y };
+			for (int i = 0; i < 4; i++) {
+				if (!parseInt(numbers[i], fields[i])) {
+					return fail("expected a number but found '" + string(numbers[i]) + "' in territory " + string(name));
 				}
+			}
+			tempCountries.push_back(new Territory(fields[0], string(name), fields[1], fields[2], fields[3]));
+		}
 
-				//cout << "Continents read!" << endl;
+		else if (section == MapSection::Borders) {
+			// <index> <neighbour index> <neighbour index> ...
+			int countryNumber, neighbour;
+			nextToken(line, token);
+			if (!parseInt(token, countryNumber)) {
+				return fail("expected a territory index but found '" + string(token) + "'");
+			}
+			while (nextToken(line, token)) {
+				if (!parseInt(token, neighbour)) {
+					return fail("expected the index of a neighbour of territory " + to_string(countryNumber) + " but found '" + string(token) + "'");
+				}
+				// Add edge tuple to the map (the map links the territories together once it is built)
+				tempBorders.emplace_back(countryNumber, neighbour);
 			}
+		}
+	}
 
-			else if (currentLine == "[countries]") {
-				// Read every line in the countries section of the text file
-				while (getline(mapFile, currentLine)) {
-					// An empty line marks the end of that section
-					if (currentLine == "") {
-						break;
-					}
+	// Generate and return a map from the data read from the map file
+	return new Map(move(tempContinents), move(tempCountries), move(tempBorders));
+}
 
-					else {
-						// Get country fields
-						int offset = 0;
+// **************************************
+// COMPILED MAP CACHE
+// **************************************
 
-						string countryNumber = currentLine.substr(0, currentLine.find(delimiter, offset)); // Number
-						offset += countryNumber.length() + delimiter.length();
+/*
+	Layout of a compiled map cache, in the byte order of the machine that wrote it:
+		CacheHeader
+		CachedContinent[numContinents]
+		CachedTerritory[numTerritories]
+		uint32_t adjacencyOffsets[numTerritories + 1]
+		uint32_t adjacency[numAdjacency]     (positions of the neighbours in the territory records)
+		char names[namesSize]                (every name, back to back)
+*/
+struct CacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t byteOrder; // Always written as 0x01020304, so a cache from a machine with another byte order is rejected
+	uint32_t valid;
+	uint64_t contentsHash;
+	uint32_t numContinents;
+	uint32_t numTerritories;
+	uint32_t numAdjacency;
+	uint32_t namesSize;
+};
+
+struct CachedContinent {
+	int32_t index;
+	int32_t armies;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+};
+
+struct CachedTerritory {
+	int32_t index;
+	int32_t continent;
+	int32_t x;
+	int32_t y;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+};
+
+static const char cacheMagic[4] = { 'W', 'Z', 'M', 'C' };
+static const uint32_t cacheVersion = 1;
+static const uint32_t cacheByteOrder = 0x01020304;
+
+string MapLoader::cacheFileName(const string& fileName) {
+	return fileName + ".cache";
+}
 
-						string countryName = currentLine.substr(offset, currentLine.find(delimiter, offset) - offset); // Name
-						offset += countryName.length() + delimiter.length();
+void MapLoader::forgetLoadedTopologies() {
+	lock_guard<mutex> lock(loadedTopologiesMutex);
+	loadedTopologies.clear();
+}
 
-						string continent = currentLine.substr(offset, currentLine.find(delimiter, offset) - offset); // Continent that it's on
-						offset += continent.length() + delimiter.length();
+// Appends the bytes of a record to the cache being written
+template <typename T>
+static void appendRecord(string& buffer, const T& record) {
+	buffer.append((const char*)&record, sizeof(T));
+}
 
-						string x = currentLine.substr(offset, currentLine.find(delimiter, offset) - offset); // X position
-						offset += x.length() + delimiter.length();
+bool MapLoader::saveCache(Map* map) {
+	if (map == NULL || !map->valid || map->sourceFile.empty() || map->topology->cached) {
+		return true;
+	}
+	const MapTopology& topology = *map->topology;
+
+	string names;
+	CacheHeader header;
+	memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+	header.version = cacheVersion;
+	header.byteOrder = cacheByteOrder;
+	header.valid = 1;
+	header.contentsHash = map->sourceHash;
+	header.numContinents = (uint32_t)topology.continents.size();
+	header.numTerritories = (uint32_t)topology.territories.size();
+	header.numAdjacency = (uint32_t)topology.adjacency.size();
+
+	string records;
+	for (const Continent& continent : topology.continents) {
+		string name = continent.getName();
+		appendRecord(records, CachedContinent{ continent.getIndex(), continent.getArmies(), (uint32_t)names.size(), (uint32_t)name.size() });
+		names += name;
+	}
+	for (const MapTopology::TerritoryInfo& t : topology.territories) {
+		appendRecord(records, CachedTerritory{ t.index, t.continent, t.x, t.y, (uint32_t)names.size(), (uint32_t)t.name.size() });
+		names += t.name;
+	}
+	for (int offset : topology.adjacencyOffsets) {
+		appendRecord(records, (uint32_t)offset);
+	}
+	for (int neighbour : topology.adjacency) {
+		appendRecord(records, (uint32_t)neighbour);
+	}
+	header.namesSize = (uint32_t)names.size();
 
-						string y = currentLine.substr(offset, currentLine.find(delimiter, offset) - offset); // Y position
+	// Games running in parallel may save the same cache: each writes its own temporary file, then moves it into place in one step
+	string cacheFile = cacheFileName(map->sourceFile);
+	string temporaryFile = cacheFile + ".tmp" + to_string(hash<thread::id>()(this_thread::get_id()));
+	{
+		ofstream out(temporaryFile, ofstream::binary | ofstream::trunc);
+		out.write((const char*)&header, sizeof(header));
+		out.write(records.data(), records.size());
+		out.write(names.data(), names.size());
+		if (!out) {
+			out.close();
+			remove(temporaryFile.c_str());
+			return false;
+		}
+	}
+	if (rename(temporaryFile.c_str(), cacheFile.c_str()) != 0) {
+		remove(temporaryFile.c_str());
+		return false;
+	}
 
-						Territory* t = new Territory(stoi(countryNumber), countryName, stoi(continent), stoi(x), stoi(y));
-						tempCountries.push_back(t);
-					}
-				}
+	topology.cached = true;
+	return true;
+}
 
-				//cout << "Countries read!" << endl;
-			}
+shared_ptr<const MapTopology> MapLoader::loadCache(const string& fileName, uint64_t contentsHash) {
+	MappedFile cacheFile(cacheFileName(fileName));
+	string_view data = cacheFile.contents();
 
-			else if (currentLine == "[borders]") {
-				while (getline(mapFile, currentLine)) {
-					// An empty line marks the end of that section
-					if (currentLine == "") {
-						break;
-					}
-
-					else {
-						// Get border fields
-						int offset = 0;
-						string countryNumber = currentLine.substr(0, currentLine.find(delimiter) - offset);
-
-						offset += countryNumber.length() + delimiter.length();
-
-						vector<string> adjCountries;
-
-						while (offset < (int)currentLine.length()) {
-							string sharedBorder = currentLine.substr(offset, currentLine.find(delimiter, offset) - offset);
-							adjCountries.push_back(sharedBorder);
-							offset += sharedBorder.length() + delimiter.length();
-						}
-
-						for (string s : adjCountries)
-						{
-							// Add edge tuple to the map
-							tuple<int, int> edge = { stoi(countryNumber), stoi(s) };
-							tempBorders.push_back(edge);
-
-							// Add territory pointer to the current node
-							tempCountries.at(stoi(countryNumber) - 1)->addAdjacentCountry(tempCountries.at(stoi(s) - 1));
-						}
-					}
-				}
+	CacheHeader header;
+	if (!cacheFile.isOpen() || data.size() < sizeof(header)) {
+		return nullptr;
+	}
+	memcpy(&header, data.data(), sizeof(header));
+	if (memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0 || header.version != cacheVersion || header.byteOrder != cacheByteOrder
+		|| header.contentsHash != contentsHash || header.valid != 1) {
+		return nullptr;
+	}
 
-				//cout << "Borders read!" << endl;
-			}
+	// The sizes of every section must add up to the size of the file (computed in 64 bits, so corrupted counts cannot overflow)
+	uint64_t continentsAt = sizeof(header);
+	uint64_t territoriesAt = continentsAt + (uint64_t)header.numContinents * sizeof(CachedContinent);
+	uint64_t offsetsAt = territoriesAt + (uint64_t)header.numTerritories * sizeof(CachedTerritory);
+	uint64_t adjacencyAt = offsetsAt + ((uint64_t)header.numTerritories + 1) * sizeof(uint32_t);
+	uint64_t namesAt = adjacencyAt + (uint64_t)header.numAdjacency * sizeof(uint32_t);
+	if (namesAt + header.namesSize != data.size()) {
+		return nullptr;
+	}
+	const char* base = data.data();
+	string_view names(base + namesAt, header.namesSize);
+
+	shared_ptr<MapTopology> topology = make_shared<MapTopology>();
+	topology->continents.reserve(header.numContinents);
+	topology->territories.reserve(header.numTerritories);
+	topology->borders.reserve(header.numAdjacency);
+
+	for (uint32_t i = 0; i < header.numContinents; i++) {
+		CachedContinent c;
+		memcpy(&c, base + continentsAt + i * sizeof(CachedContinent), sizeof(c));
+		if ((uint64_t)c.nameOffset + c.nameLength > names.size()) {
+			return nullptr;
 		}
+		topology->continents.emplace_back(c.index, string(names.substr(c.nameOffset, c.nameLength)), c.armies);
+	}
 
-		// We've finished reading the file, close it.
-		mapFile.close();
-
-		// Generate and return a map from the data read from the map file
-		Map* m = new Map(tempContinents, tempCountries, tempBorders);
-		return m;
+	vector<uint32_t> offsets(header.numTerritories + 1);
+	memcpy(offsets.data(), base + offsetsAt, offsets.size() * sizeof(uint32_t));
+	for (uint32_t i = 0; i < header.numTerritories; i++) {
+		CachedTerritory t;
+		memcpy(&t, base + territoriesAt + i * sizeof(CachedTerritory), sizeof(t));
+		if ((uint64_t)t.nameOffset + t.nameLength > names.size() || offsets[i] > offsets[i + 1] || offsets[i + 1] > header.numAdjacency) {
+			return nullptr;
+		}
+		topology->territories.push_back({ t.index, string(names.substr(t.nameOffset, t.nameLength)), t.continent, t.x, t.y });
 	}
 
-	catch (const exception& e) {
-		cout << e.what() << endl;
-		exit(1);
-		//return NULL;
+	// The topology rebuilds its adjacency table from the borders, in the same order
+	for (uint32_t i = 0; i < header.numTerritories; i++) {
+		for (uint32_t e = offsets[i]; e < offsets[i + 1]; e++) {
+			uint32_t neighbour;
+			memcpy(&neighbour, base + adjacencyAt + e * sizeof(uint32_t), sizeof(neighbour));
+			if (neighbour >= header.numTerritories) {
+				return nullptr;
+			}
+			topology->borders.emplace_back(topology->territories[i].index, topology->territories[neighbour].index);
+		}
 	}
-}
\ No newline at end of file
+
+	topology->buildTables();
+	// Only valid maps are saved to the cache
+	topology->knownValid = true;
+	topology->cached = true;
+	return topology;
+}
@@ -11,12 +11,159 @@
 #include <vector>
 #include <tuple>
 #include <exception>
+#include <string_view>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include "../Player/Player.h"
+#include "../Game Engine/Output.h"
 
 using namespace std;
 
 // Forward declaration
 class Player;
+class Territory;
+class Map;
+class TerritoryState;
+
+/**
+	* Non-owning, read-only view over a contiguous run of territory pointers (such as a territory's neighbours).
+	*
+	* Iterating over a span never allocates: it only walks the memory owned by whoever created it (normally the map's adjacency table). A span stays valid
+	* for as long as the object that owns that memory is alive and unchanged.
+	*/
+class TerritorySpan
+{
+private:
+	Territory* const* first;
+	Territory* const* last;
+
+public:
+	TerritorySpan() : first(nullptr), last(nullptr) {}
+	TerritorySpan(Territory* const* first, Territory* const* last) : first(first), last(last) {}
+
+	Territory* const* begin() const { return first; }
+	Territory* const* end() const { return last; }
+	size_t size() const { return last - first; }
+	bool empty() const { return first == last; }
+	Territory* operator[](size_t i) const { return first[i]; }
+};
+
+/**
+	* Per-game territory state (owner and army count) stored as a structure of arrays.
+	*
+	* Every territory of a map is given a slot, and the slot's owner and army count live in two contiguous arrays rather than inside each Territory object. The
+	* phases of the game that only care about who owns what and how many armies are where (reinforcement, win detection, strategy scoring) can then scan packed
+	* integers instead of chasing territory pointers across the heap. Owners are stored as small integer ids; the id of a player is assigned the first time it owns
+	* a territory in this state.
+	*
+	* The state also keeps, for every player and every continent, how many of the continent's territories the player owns. These counters are updated on every
+	* change of owner, so a player's continent bonus is always known without looking at the territories again.
+	*
+	* FIELDS:
+	*
+	* ownerIds <vector<int>>: Id of the player that owns each slot, -1 if nobody owns it.
+	* armies <vector<int>>: Number of armies on each slot.
+	* players <vector<Player*>>: The player behind each id.
+	* slotContinent <vector<int>>: Position (in the map's continent list) of the continent each slot belongs to, -1 if it belongs to none.
+	* continentSizes <vector<int>>: Number of territories in each continent.
+	* continentArmies <vector<int>>: Army bonus of each continent.
+	* continentCounts <vector<int>>: Number of territories of each continent owned by each player (entry id * number of continents + continent).
+	* continentBonus <vector<int>>: Sum of the bonuses of the continents each player fully owns.
+	* adjacencyOffsets, adjacency <const vector<int>*>: The topology's adjacency table (see MapTopology), nullptr until setAdjacency() is called.
+	* neighbourCounts <vector<int>>: Number of each player's slots that have each slot as a neighbour (entry id * number of slots + slot).
+	* frontiers <vector<vector<int>>>: Each player's frontier: the slots it does not own that are neighbours of one of its slots, in no particular order.
+	* frontierPositions <vector<int>>: Position of each slot in each player's frontier, -1 if it is not in it (entry id * number of slots + slot).
+	*
+	* Like the continent counters, the frontiers are updated on every change of owner, by walking the neighbours of the slot that changed hands only.
+	*
+	* ownedCounts <vector<int>>: Number of slots each player owns.
+	* ownershipEvents <vector<int>>: Ids of the players whose count has dropped to 0 or reached the number of slots since takeOwnershipEvents() was last called.
+	* eventPending <vector<char>>: Whether each player id is already in ownershipEvents.
+	*
+	* epoch <uint64_t>: Bumped on every change of owner or army count, so whoever caches something computed from the state knows when to compute it again.
+	*/
+class TerritoryState
+{
+private:
+	vector<int> ownerIds;
+	vector<int> armies;
+	vector<Player*> players;
+
+	vector<int> slotContinent;
+	vector<int> continentSizes;
+	vector<int> continentArmies;
+	vector<int> continentCounts;
+	vector<int> continentBonus;
+
+	const vector<int>* adjacencyOffsets = nullptr;
+	const vector<int>* adjacency = nullptr;
+	vector<int> neighbourCounts;
+	vector<vector<int>> frontiers;
+	vector<int> frontierPositions;
+	vector<int> ownedCounts;
+	vector<int> ownershipEvents;
+	vector<char> eventPending;
+	uint64_t epoch = 0;
+
+	// Moves a slot's contribution to the continent counters from one owner id to another
+	void transferContinent(int slot, int fromId, int toId);
+	// Moves a slot's contribution to the frontiers from one owner id to another (the slot's owner must already be toId)
+	void transferFrontier(int slot, int fromId, int toId);
+	void addToFrontier(int id, int slot);
+	void removeFromFrontier(int id, int slot);
+	// Id of a player, assigned (and the per-player tables grown) on first use; -1 for nullptr
+	int registerPlayer(Player* player);
+	// Moves a slot from one owner id's count to another's, recording an ownership event when a count drops to 0 or reaches every slot
+	void transferCount(int fromId, int toId);
+
+public:
+	// Resizes the state to hold 'size' slots (new slots are unowned and empty)
+	void resize(int size);
+	int size();
+
+	// Sets up the continent counters: 'slotContinents' gives each slot's continent position (-1 for none), 'bonuses' gives each continent's army bonus.
+	// Must be called while no slot is owned.
+	void setContinents(vector<int> slotContinents, vector<int> bonuses);
+	// Sets up the frontiers from an adjacency table in the layout of MapTopology's (the neighbours of slot i are adjacency[offsets[i]] to
+	// adjacency[offsets[i + 1] - 1]). The table is not copied and must outlive the state. Must be called while no slot is owned.
+	void setAdjacency(const vector<int>* offsets, const vector<int>* adjacency);
+
+	int getOwnerId(int slot);
+	Player* getOwner(int slot);
+	void setOwner(int slot, Player* player);
+
+	int getArmies(int slot);
+	void setArmies(int slot, int numArmies);
+
+	// Id of a player in this state, -1 for nullptr or a player that has never owned a slot. Only looks the player up: ids are
+	// assigned by setOwner, so queries about other players do not grow the per-player tables.
+	int findPlayerId(Player* player);
+	Player* getPlayer(int id);
+
+	// Maintained on every change of owner
+	int countOwnedBy(Player* player);
+	// Linear scan over the packed arrays
+	int armiesOwnedBy(Player* player);
+
+	// Appends the players that lost their last slot or came to own every slot since the last call, in the order it happened and
+	// each once, then forgets them. A player is only reported when its count changes, so the game over checks cost nothing
+	// in the rounds where nobody was eliminated or won.
+	void takeOwnershipEvents(vector<Player*>& players);
+
+	// Maintained on every change of owner
+	int getContinentBonus(Player* player);
+	bool ownsContinent(Player* player, int continent);
+	// Slots the player could attack: those it does not own that are neighbours of one of its slots, each once, in no particular order
+	const vector<int>& getFrontier(Player* player);
+
+	const vector<int>& getOwnerIds();
+	const vector<int>& getArmyCounts();
+
+	// Changes every time an owner or an army count changes
+	uint64_t getEpoch() const;
+};
 
 /**
 	* Implementation of a "Continent" object to be used in Warzone.
@@ -53,9 +200,9 @@ public:
 	~Continent();
 
 	// MEMBER FUNCTIONS
-	string getName();
-	int getArmies();
-	int getIndex();
+	string getName() const;
+	int getArmies() const;
+	int getIndex() const;
 };
 
 /**
@@ -67,12 +214,16 @@ public:
 	*
 	* FIELDS:
 	*
-	* owner <Player>: The player who owns this territory.
-	* numberOfArmies <int>: The amount of armies that a player had devoted to this territory.
+	* owner <Player>: The player who owns this territory (only used for territories built outside of a map).
+	* numberOfArmies <int>: The amount of armies that a player had devoted to this territory (only used for territories built outside of a map).
+	* state <TerritoryState*>: The state of the map this territory belongs to, which holds its owner and army count (set by the map, nullptr otherwise).
+	* slot <int>: This territory's slot in 'state'.
+	* ownedPosition <int>: This territory's position in its owner's list of owned territories, -1 if it is in nobody's list (maintained by Player).
 	* countryIndex <int>: This territory's unique identifier. No two countries may have the same index.
 	* name <string>: This territory's name.
 	* parent <int>: The index of the continent that this territory is a part of.
-	* adjacentCountries <vector<Territory*>>: A collection of pointers that point to this territory's neighbouring countries.
+	* adjacentCountries <vector<Territory*>>: A collection of pointers that point to this territory's neighbouring countries (only used for territories built outside of a map).
+	* neighbours <TerritorySpan>: This territory's slice of the adjacency table of the map it belongs to (set by the map, empty otherwise).
 	* x <int>: The x component of this territory's cartesian coordinate (Normally, a circle is drawn on the map with this country's index, this field helps decide where that circle is drawn.).
 	* y <int>: The y component of this territory's cartesian coordinate (Normally, a circle is drawn on the map with this country's index, this field helps decide where that circle is drawn.).
 	*/
@@ -86,6 +237,18 @@ private:
 	int parent;
 
 	vector<Territory*> adjacentCountries; // This will store the nodes with which this node shares borders
+	TerritorySpan neighbours; // Points into the owning map's adjacency table once the map has been built
+
+	// Owner and army count live in the owning map's state once the map has been built
+	TerritoryState* state = nullptr;
+	int slot = -1;
+
+	// Lets the owner remove this territory from its list in constant time
+	int ownedPosition = -1;
+
+	friend class Player;
+
+	friend class Map;
 
 	// Cartesian coordinates for the territory on the map
 	int x;
@@ -108,7 +271,7 @@ public:
 	friend ostream& operator<<(ostream& out, const Territory& t);
 
 	// Evaluates equivalency between two territories by comparing their indices. Returns 'true' if both indices are equivalent, 'false' otherwise.
-	friend bool& operator==(const Territory& lhs, const Territory& rhs);
+	friend bool operator==(const Territory& lhs, const Territory& rhs);
 
 	// MEMBER FUNCTIONS
 	int getIndex();
@@ -116,7 +279,7 @@ public:
 	int getNumberOfArmies();
 	string getName();
 	int getContinent();
-	vector<Territory*> getAdjacentTerritories();
+	TerritorySpan getAdjacentTerritories(); // Does not allocate; see TerritorySpan
 	int getX();
 	int getY();
 
@@ -148,30 +311,171 @@ struct InvalidMapException : std::exception {
 	const string error() const throw();
 };
 
+/**
+	* A single problem found while validating a map.
+	*
+	* FIELDS:
+	*
+	* error <MAP_ERRORS>: The kind of problem that was found.
+	* index <int>: The territory index (ISOLATED_NODE) or the continent index (DISCONNECTED_SUBGRAPH, EMPTY_CONTINENT) the problem refers to.
+	*/
+struct MapValidationIssue {
+	InvalidMapException::MAP_ERRORS error;
+	int index;
+};
+
+/**
+	* Result of a connectivity check over a map. An empty report means the map is valid.
+	*
+	* FIELDS:
+	*
+	* issues <vector<MapValidationIssue>>: Every problem found, in the order in which it was found.
+	*/
+struct MapValidationReport {
+	vector<MapValidationIssue> issues;
+
+	bool isValid() const;
+	int count(InvalidMapException::MAP_ERRORS error) const;
+};
+
+/**
+	* Immutable description of a map: everything about it that never changes during a game.
+	*
+	* The topology holds the continents, the static fields of the territories (index, name, continent and coordinates), the borders, and every table derived
+	* from them. Territories are referred to by position rather than by pointer, so the topology does not belong to any one game. It never changes once built
+	* and is reference-counted (shared_ptr), so any number of games, including games running in parallel, can share one topology. Each game's Map only adds its
+	* own Territory objects and their TerritoryState on top of it.
+	*
+	* FIELDS:
+	*
+	* continents <vector<Continent>>: The continents, in the order of the map file.
+	* territories <vector<TerritoryInfo>>: The static fields of every territory, in the order of the map file. A territory's position is its place in this vector.
+	* borders <vector<tuple<int,int>>>: Collection of pairs of country indices where each pair defines the link (or shared border) between those countries.
+	* territoryPosition <vector<int>>: Position of the territory with a given index (-1 if there is none), used for constant-time lookups.
+	* adjacencyOffsets <vector<int>>: The neighbours of the territory at position i are adjacency[adjacencyOffsets[i]] to adjacency[adjacencyOffsets[i + 1] - 1].
+	* adjacency <vector<int>>: Positions of every territory's neighbours, stored back to back (compressed sparse row layout).
+	* continentPosition <vector<int>>: Position in 'continents' of the continent with a given index (-1 if there is none).
+	* territoryContinent <vector<int>>: Position in 'continents' of the continent of the territory at a given position (-1 if it has none).
+	* continentOffsets <vector<int>>: The members of the continent at position c are continentMembers[continentOffsets[c]] to continentMembers[continentOffsets[c + 1] - 1].
+	* continentMembers <vector<int>>: Positions of every continent's territories, stored back to back.
+	* continentArmies <vector<int>>: Army bonus of the continent at each position.
+	* report <MapValidationReport>: Result of checkConnectivity(), worked out the first time it is needed (or known from the compiled map cache).
+	* cached <atomic<bool>>: True once the compiled map cache of the topology's map file is known to be up to date (see MapLoader).
+	*/
+class MapTopology
+{
+private:
+	struct TerritoryInfo {
+		int index;
+		string name;
+		int continent;
+		int x;
+		int y;
+	};
+
+	vector<Continent> continents;
+	vector<TerritoryInfo> territories;
+	vector<tuple<int, int>> borders;
+
+	vector<int> territoryPosition;
+	vector<int> adjacencyOffsets;
+	vector<int> adjacency;
+
+	vector<int> continentPosition;
+	vector<int> territoryContinent;
+	vector<int> continentOffsets;
+	vector<int> continentMembers;
+	vector<int> continentArmies;
+
+	mutable once_flag checked;
+	mutable MapValidationReport report;
+	bool knownValid = false;
+	mutable atomic<bool> cached{ false };
+
+	// Builds every derived table from 'continents', 'territories' and 'borders'
+	void buildTables();
+	MapValidationReport checkConnectivity() const;
+
+	friend class Map;
+	friend class MapLoader;
+
+public:
+	// Empty topology
+	MapTopology();
+	// Topology of the given continents, territories and borders (their static fields are copied, the objects themselves are not kept)
+	MapTopology(const vector<Continent*>& continents, const vector<Territory*>& territories, vector<tuple<int, int>> borders);
+	MapTopology(const MapTopology&) = delete;
+	MapTopology& operator=(const MapTopology&) = delete;
+
+	int size() const;
+	// Position of the territory with the given index, -1 if there is none
+	int getPosition(int index) const;
+	// Read-only tables, by position (see FIELDS), for code that works on positions instead of Territory objects
+	const vector<int>& getAdjacencyOffsets() const;
+	const vector<int>& getAdjacency() const;
+	const vector<int>& getContinentOffsets() const;
+	const vector<int>& getContinentMembers() const;
+	const vector<int>& getContinentArmies() const;
+	// Problems with the map's connectivity, checked once per topology whatever the number of games that use it. Safe to call from several threads.
+	const MapValidationReport& getValidationReport() const;
+};
+
 /**
 	* Implementation of the map on which the Warzone game is played on.
 	*
 	* This class stores all the information defined in the map file, namely all the continents, countries and the borders between those countries. It also has the capability to verify
 	* its own validity (all countries are connected, all continents are connected subgraphs, etc.).
 	*
+	* Everything that never changes during a game lives in the map's topology (see MapTopology), which may be shared with other games. The map itself only holds
+	* what belongs to one game: its Continent and Territory objects, pointer tables that lead from each territory to the map's own neighbouring territories, and
+	* the owner and army count of every territory. A map built from a shared topology creates its objects in one block each, so starting a game on a map that is
+	* already loaded costs a handful of allocations and O(territories) copies. The setters never change a topology in place: they build a new one for this map
+	* (copy-on-write), leaving other games untouched.
+	*
 	* FIELDS:
 	*
-	* continents <vector<Continent*>>: Collection of pointers to defined continents.
-	* countries <vector<Territory*>>: Collection of pointers to defined countries.
-	* borders <vector<tuple<int,int>>>: Collection of pairs of country indices where each pair defines the link (or shared border) between those countries.
+	* topology <shared_ptr<const MapTopology>>: The static part of the map, possibly shared with other games.
+	* continentBlock <vector<Continent>>, territoryBlock <vector<Territory>>: The objects of a map built from a shared topology, created in one block each.
+	* continents <vector<Continent*>>: Collection of pointers to defined continents, in the order of the topology.
+	* countries <vector<Territory*>>: Collection of pointers to defined countries, in the order of the topology (the territory at position i is countries[i]).
+	* adjacency <vector<Territory*>>: Every territory's neighbours, laid out like the topology's adjacency table but pointing at this map's territories.
+	* continentMembers <vector<Territory*>>: Every continent's territories, laid out like the topology's continent table but pointing at this map's territories.
+	* state <TerritoryState>: Owner and army count of every territory, in the same order as 'countries'.
+	* sourceFile <string>: The map file the map was loaded from ("" if it was built in code).
+	* sourceHash <uint64_t>: Hash of the contents of 'sourceFile', which the compiled map cache is checked against.
 	*/
 class Map // This is the graph
 {
 private:
+	shared_ptr<const MapTopology> topology;
+	vector<Continent> continentBlock;
+	vector<Territory> territoryBlock;
+
 	vector<Continent*> continents;
 	vector<Territory*> countries;
-	vector<tuple<int, int>> borders;
 	bool valid;
 
+	string sourceFile;
+	uint64_t sourceHash = 0;
+
+	friend class MapLoader;
+
+	vector<Territory*> adjacency;
+	vector<Territory*> continentMembers;
+
+	TerritoryState state;
+
+	// Replaces the topology with a new one built from the map's continents and territories and the given borders, then rebinds the map to it
+	void buildTables(vector<tuple<int, int>> borders);
+	// Points every territory at its neighbours and its state slot, following the topology
+	void bindTopology();
+
 public:
 	Map();
 	Map(const Map& m);
 	Map(vector<Continent*> continents, vector<Territory*> countries, vector<tuple<int, int>> borders);
+	// Map for a new game over an existing topology, with its own territories (all unowned and empty)
+	explicit Map(shared_ptr<const MapTopology> topology);
 
 	// OPERATOR OVERLOADS
 	Map& operator=(const Map& m);
@@ -183,28 +487,53 @@ public:
 	vector<Territory*> getTerritories();
 	vector<tuple<int, int>> getBorders();
 	bool isValid();
+	// Map file the map was loaded from ("" if it was built in code)
+	string getSourceFile();
+	// The static part of the map, which can be shared with other games
+	shared_ptr<const MapTopology> getTopology();
+	// New map over the same topology whose territories have the same owners and army counts as this map's (for looking ahead without touching this game).
+	// Costs O(territories) copies and no parsing. The players' lists of owned territories still refer to this map's territories.
+	Map* clone();
 
 	vector<tuple<int, int>> getBordersByCountry(Territory country);
 
-	vector<Territory*> getTerritoriesByContinent(int continent);
+	TerritorySpan getTerritoriesByContinent(int continent); // Does not allocate; see TerritorySpan
 
 	void setContinents(vector<Continent*> continents);
 	void setTerritories(vector<Territory*> territories);
 	void setBorders(vector<tuple<int, int>> borders);
 
+	// The setters and adders below rebuild the topology, so maps should be built in one go (see MapLoader) rather than one border at a time
 	void addContinent(Continent* continent);
 	void addTerritory(Territory* territory);
 	void addBorder(tuple<int, int> border);
 
-	bool borderExists(vector<Territory*> toCheck, Territory destination, vector<Territory> checked);
+	// Position of the territory with the given index in getTerritories(), -1 if there is none
+	int getPosition(int index);
+
+	// Neighbours of a territory, straight out of the adjacency table
+	TerritorySpan getNeighbours(Territory* territory);
+
+	// Owner and army count of every territory (slot i is the territory at position i in getTerritories())
+	TerritoryState* getState();
+
+	MapValidationReport checkConnectivity();
 	void validate();
+	// Same as validate(), but writes the result to the given output
+	void validate(Output& output);
 
-	// Calculate the continent bonus a player gets in their reinforcement pool
+	// Calculate the continent bonus a player gets in their reinforcement pool (read from the state's counters, see TerritoryState)
 	int calculateContinentBonus(Player* player);
 
 	static bool territoryExists(vector<Territory> collection, Territory toFind);
 
-    Territory* getTerritoryByIndex(int index);
+	Territory* getTerritoryByIndex(int index);
+	// Territory at the given position in getTerritories() (and slot in getState()), without copying the list
+	Territory* getTerritoryAt(int position);
+
+	// Territories the player could attack (see TerritoryState::getFrontier), in map order. Only the frontier is sorted, it is
+	// never rebuilt from the player's territories.
+	vector<Territory*> getFrontier(Player* player);
 
 	// DESTRUCTOR
 	~Map();
@@ -215,10 +544,32 @@ public:
 	*
 	* This class is not intended to be instantiated, rather, it exposes a single function which takes in the path to the map file to be used. It then uses the path to read the file
 	* and generates a map from it, which it then returns upon exit.
+	*
+	* Once a map has been validated, it can be saved to a compiled map cache next to the map file ('<map file>.cache'). The cache holds the continents, the territories, the
+	* adjacency table and the validity of the map in a flat binary layout, along with a hash of the map file's contents. The next time the same map file is loaded, the cache
+	* is read in one go instead of parsing the text, and the map comes back already validated. A cache whose hash does not match the map file is stale and is ignored.
+	*
+	* The topology of every map file loaded is also kept in memory for the rest of the program. Loading the same file again, with the same contents, gives a new Map over the
+	* topology already loaded, without reading the text or the cache at all (see MapTopology).
 	*/
 class MapLoader
 {
 private:
+	// Builds a map from the text of a map file
+	static Map* parseMap(string_view contents, const string& fileName, string& error);
+	// Reads the topology of a map file from its compiled map cache, nullptr if there is no usable cache for the given contents hash
+	static shared_ptr<const MapTopology> loadCache(const string& fileName, uint64_t contentsHash);
+
 public:
+	// Loads a map file, printing what is wrong with it and returning NULL if it cannot be loaded
 	static Map* createMapfromFile(string fileName);
+	// Loads a map file. If it cannot be loaded, returns NULL and sets 'error' to what is wrong with it, with the line number
+	static Map* createMapfromFile(string fileName, string& error);
+	// Saves a valid map to the compiled map cache of the file it was loaded from. Does nothing if the map is invalid, was not loaded from a file, or the cache is already up to date.
+	// Returns false if the cache could not be written.
+	static bool saveCache(Map* map);
+	// Name of the compiled map cache of a map file
+	static string cacheFileName(const string& fileName);
+	// Forgets the topologies loaded so far, so the next load of every map file reads it again (maps already loaded keep their topology)
+	static void forgetLoadedTopologies();
 };
\ No newline at end of file
@@ -26,6 +26,9 @@ int main()
 	Player* p = new Player();
 
 	Map* testMap = MapLoader::createMapfromFile(fileName);
+	if (testMap == NULL) {
+		return 1;
+	}
 
 	// Display map properties
 	cout << endl;
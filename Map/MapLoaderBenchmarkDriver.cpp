@@ -0,0 +1,105 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include "Map.h"
+
+using namespace std;
+
+// Writes a map of 'numTerritories' territories laid out on a grid, each bordering the territories next to it, in continents of 'continentSize' territories
+static void generateMap(string fileName, int numTerritories, int continentSize) {
+	ofstream out(fileName);
+	int width = 300;
+	int numContinents = (numTerritories + continentSize - 1) / continentSize;
+
+	out << "[files]\npic generated.jpg\n\n[continents]\n";
+	for (int c = 1; c <= numContinents; c++) {
+		out << "Continent" << c << " " << (c % 7 + 1) << " yellow\n";
+	}
+
+	out << "\n[countries]\n";
+	for (int t = 1; t <= numTerritories; t++) {
+		out << t << " Territory" << t << " " << ((t - 1) / continentSize + 1) << " " << (t - 1) % width << " " << (t - 1) / width << "\n";
+	}
+
+	out << "\n[borders]\n";
+	for (int t = 1; t <= numTerritories; t++) {
+		out << t;
+		int column = (t - 1) % width;
+		if (column > 0) out << " " << t - 1;
+		if (column < width - 1 && t < numTerritories) out << " " << t + 1;
+		if (t > width) out << " " << t - width;
+		if (t + width <= numTerritories) out << " " << t + width;
+		out << "\n";
+	}
+}
+
+// Best time to load the given map file, in milliseconds. Unless 'shared', every load reads the file instead of reusing the topology already loaded.
+static double timeLoad(string fileName, int runs, bool shared = false) {
+	double best = 0;
+	for (int run = 0; run < runs; run++) {
+		if (!shared) {
+			MapLoader::forgetLoadedTopologies();
+		}
+		auto start = chrono::steady_clock::now();
+		Map* map = MapLoader::createMapfromFile(fileName);
+		auto end = chrono::steady_clock::now();
+		double ms = chrono::duration<double, milli>(end - start).count();
+		best = run == 0 ? ms : min(best, ms);
+		delete map;
+	}
+	return best;
+}
+
+int main() {
+	cout << "Map loading\n" << endl;
+
+	int sizes[] = { 1000, 10000, 100000 };
+	for (int n : sizes) {
+		string fileName = "generated_" + to_string(n) + ".map";
+		generateMap(fileName, n, 50);
+
+		const int runs = 5;
+		remove(MapLoader::cacheFileName(fileName).c_str());
+		MapLoader::forgetLoadedTopologies();
+		double textMs = timeLoad(fileName, runs);
+
+		// Validate once and save the compiled map cache, then load through the cache
+		Map* map = MapLoader::createMapfromFile(fileName);
+		map->validate();
+		MapLoader::saveCache(map);
+		delete map;
+		MapLoader::forgetLoadedTopologies();
+		double cacheMs = timeLoad(fileName, runs);
+
+		// Games after the first share the topology already loaded, or copy the state of a game in progress
+		double sharedMs = timeLoad(fileName, runs, true);
+		map = MapLoader::createMapfromFile(fileName);
+		double cloneMs = 0;
+		for (int run = 0; run < runs; run++) {
+			auto start = chrono::steady_clock::now();
+			Map* copy = map->clone();
+			double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+			cloneMs = run == 0 ? ms : min(cloneMs, ms);
+			delete copy;
+		}
+
+		cout << n << " territories: " << map->getTerritories().size() << " territories, " << map->getBorders().size() << " borders, valid = " << map->isValid()
+			<< ". Text file: " << textMs << " ms, compiled map cache: " << cacheMs << " ms, shared topology: " << sharedMs << " ms, clone: " << cloneMs
+			<< " ms (best of " << runs << ")" << endl;
+		delete map;
+		remove(fileName.c_str());
+		remove(MapLoader::cacheFileName(fileName).c_str());
+	}
+
+	// A malformed line is reported with its line number instead of ending the program
+	string fileName = "malformed.map";
+	{
+		ofstream out(fileName);
+		out << "[continents]\nNorth 5\n\n[countries]\n1 A 1 0 0\n2 B one 1 0\n";
+	}
+	string error;
+	Map* malformed = MapLoader::createMapfromFile(fileName, error);
+	cout << "\nMalformed map: " << (malformed == NULL ? error : "loaded") << endl;
+	remove(fileName.c_str());
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include "Battle.h"
+#include <random>
+
+using namespace std;
+
+/* Rolls that kill nobody (8, 9 or 10) do not change the battle, so only the other 7 outcomes matter. On each of those the
+attacker loses an army, and the defender also loses one 6 times out of 7. The defender is checked first, so the attacker
+captures the territory if the defender's last army falls within the attacker's first `attackers` rolls.
+
+The number of rolls in which only the attacker lost an army before the defender's last army falls follows a negative
+binomial distribution, which is drawn in one go. Note that std::negative_binomial_distribution is implemented by the
+standard library, so the same seed replays the same battle only with the same standard library. */
+BattleResult Battle::resolve(int attackers, int defenders, Random& rng) {
+    BattleResult result;
+
+    if(attackers <= 0){
+        return result;
+    }
+    //An undefended territory is captured after a single roll
+    if(defenders <= 0){
+        result.captured = true;
+        result.survivors = rng.nextInt(1, 10) <= 7 ? attackers - 1 : attackers;
+        return result;
+    }
+
+    negative_binomial_distribution<int> attackerOnlyLosses(defenders, 6.0 / 7.0);
+    long long rolls = (long long)defenders + attackerOnlyLosses(rng);
+
+    if(rolls <= attackers){
+        result.captured = true;
+        result.survivors = attackers - (int)rolls;
+    }
+    return result;
+}
+
+BattleResult Battle::rollByRoll(int attackers, int defenders, Random& rng) {
+    BattleResult result;
+
+    if(attackers <= 0){
+        return result;
+    }
+    int attackingArmy = attackers;
+    int defendingArmy = defenders;
+    for(;;){
+        //Random int from 1 to 10
+        int randNumber = rng.nextInt(1, 10);
+        if(randNumber <= 6){
+            defendingArmy--;
+        }
+        if(randNumber <= 7){
+            attackingArmy--;
+        }
+        if(defendingArmy <= 0){
+            result.captured = true;
+            result.survivors = attackingArmy;
+            return result;
+        }
+        if(attackingArmy <= 0){
+            return result;
+        }
+    }
+}
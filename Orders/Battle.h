@@ -0,0 +1,22 @@
+#pragma once
+#include "../Game Engine/Random.h"
+
+using namespace std;
+
+// Outcome of an attack on an enemy territory
+struct BattleResult {
+	bool captured = false; // True if every defending army was eliminated
+	int survivors = 0; // Attacking armies left to occupy the territory when it is captured
+};
+
+/* Battle simulation used by the Advance order: every roll, an attacking army has 60% chances of killing a defending army
+while a defending army has 70% chances of killing an attacking army, until one side has no armies left. */
+class Battle {
+public:
+	/* Resolves the whole battle from a single draw instead of one roll at a time. The result follows exactly the same
+	distribution as rollByRoll(), but costs O(1) random draws whatever the size of the armies. */
+	static BattleResult resolve(int attackers, int defenders, Random& rng);
+
+	// Original roll-by-roll simulation, O(armies) random draws. Kept as the reference for resolve().
+	static BattleResult rollByRoll(int attackers, int defenders, Random& rng);
+};
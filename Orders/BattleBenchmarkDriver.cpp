@@ -0,0 +1,43 @@
+#include "Battle.h"
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+
+//Runs `battles` battles with the given method and prints the capture rate, the average survivors and the time per battle
+static void benchmark(string name, BattleResult (*method)(int, int, Random&), int attackers, int defenders, int battles) {
+    Random rng(345);
+    int captured = 0;
+    double survivors = 0;
+
+    auto start = chrono::steady_clock::now();
+    for(int i = 0; i < battles; i++){
+        BattleResult result = method(attackers, defenders, rng);
+        if(result.captured){
+            captured++;
+            survivors += result.survivors;
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    double ns = chrono::duration<double, nano>(end - start).count() / battles;
+
+    cout << "  " << name << ": captured " << (100.0 * captured / battles) << "%, average survivors "
+    << (captured > 0 ? survivors / captured : 0) << ", " << ns << " ns per battle" << endl;
+}
+
+int main(){
+    cout << "Battle resolution: roll by roll vs single draw\n" << endl;
+
+    int armies[] = {10, 1000, 100000};
+    for(int n : armies){
+        //Attackers need about 7/6 of the defending armies to win, so compare at a few ratios around it
+        int defenders[] = {n / 2, n * 6 / 7, n};
+        int battles = n >= 100000 ? 200 : 20000;
+        for(int d : defenders){
+            cout << n << " attackers vs " << d << " defenders (" << battles << " battles)" << endl;
+            benchmark("rollByRoll", Battle::rollByRoll, n, d, battles);
+            benchmark("resolve   ", Battle::resolve, n, d, battles);
+        }
+    }
+    return 0;
+}
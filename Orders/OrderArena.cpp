@@ -0,0 +1,50 @@
+#include "OrderArena.h"
+#include "Orders.h"
+#include <algorithm>
+
+OrderArena::OrderArena() {}
+
+OrderArena::~OrderArena() {
+	reset();
+}
+
+void OrderArena::reset() {
+	for (Orders* o : created) {
+		o->~Orders();
+	}
+	created.clear();
+	currentBlock = 0;
+	offset = 0;
+}
+
+size_t OrderArena::size() const {
+	return created.size();
+}
+
+size_t OrderArena::capacity() const {
+	size_t total = 0;
+	for (size_t size : blockSizes) {
+		total += size;
+	}
+	return total;
+}
+
+void* OrderArena::allocate(size_t size, size_t alignment) {
+	while (true) {
+		if (currentBlock < blocks.size()) {
+			size_t start = (offset + alignment - 1) & ~(alignment - 1);
+			if (start + size <= blockSizes[currentBlock]) {
+				offset = start + size;
+				return blocks[currentBlock].get() + start;
+			}
+			// The current block is full: move on to the next one, kept from earlier rounds if there is one
+			currentBlock++;
+			offset = 0;
+			continue;
+		}
+
+		size_t newSize = max(blockSize, size);
+		blocks.emplace_back(new char[newSize]);
+		blockSizes.push_back(newSize);
+	}
+}
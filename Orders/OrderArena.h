@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Forward declaration
+class Orders;
+
+/* Memory for the orders issued during a round. Creating an order moves a pointer along a block allocated up front, and
+reset() destroys every order created since the last reset and starts over at the first block, so the same few blocks are
+used round after round and a game runs in constant memory however long it lasts.
+
+Each game has its own arena (see GameEngine::getOrderArena), which owns the orders it creates: an OrdersList only holds
+them, and never deletes them (see Orders::isPooled). Orders created with new, as the drivers do, still belong to their list. */
+class OrderArena
+{
+public:
+	OrderArena();
+	~OrderArena();
+	// An arena owns what it created, so it cannot be copied
+	OrderArena(const OrderArena&) = delete;
+	OrderArena& operator=(const OrderArena&) = delete;
+
+	// Creates an order of type T in the arena, passing the arguments on to its constructor
+	template<class T, class... Args>
+	T* create(Args&&... args) {
+		T* order = new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+		order->pooled = true;
+		created.push_back(order);
+		return order;
+	}
+
+	// Destroys every order created since the last reset and makes their memory available again
+	void reset();
+
+	// Orders created since the last reset
+	size_t size() const;
+	// Bytes held by the arena's blocks
+	size_t capacity() const;
+
+	static constexpr size_t blockSize = 64 * 1024;
+
+private:
+	vector<unique_ptr<char[]>> blocks;
+	vector<size_t> blockSizes;
+	size_t currentBlock = 0;
+	size_t offset = 0; // First free byte of the current block
+	vector<Orders*> created;
+
+	void* allocate(size_t size, size_t alignment);
+};
@@ -1,4 +1,5 @@
 #include "Orders.h"
+#include "Battle.h"
 #include <iostream>
 #include <algorithm>
 #include <utility>
@@ -16,19 +17,89 @@ Orders::Orders() = default;
 bool Orders::getExecuted() const {
     return executed;
 }
+bool Orders::isPooled() const {
+    return pooled;
+}
 void Orders::setExecuted(bool exec) {
     this->executed = exec;
 }
 
+OrderRecord::OrderRecord() = default;
+OrderRecord::OrderRecord(Player* owner, const char* message) : outcome(OrderOutcome::Message), message(message), owner(owner) {}
+OrderRecord::OrderRecord(OrderOutcome outcome, Player* owner, Player* enemy, Territory* source, Territory* target, int armies)
+        : outcome(outcome), owner(owner), enemy(enemy), source(source), target(target), armies(armies) {}
+
+//The effect's text is only put together here, so orders that are never shown or logged do not pay for it
 string Orders::getEffect() {
-    return this->effect;
+    switch(record.outcome){
+    case OrderOutcome::Message:
+        return record.message;
+    case OrderOutcome::Custom:
+        return this->effect;
+    case OrderOutcome::Deployed:
+        return record.owner->getName() + " has deployed " + to_string(record.armies) + " armies to territory " + record.target->getName()
+        + ". Old army count = " + to_string(record.armiesBefore) + ". New army count = " + to_string(record.armiesBefore + record.armies) + "\n";
+    case OrderOutcome::Moved:
+        return record.owner->getName() + " has moved " + to_string(record.armies) + " armies from " + record.source->getName()
+        + " territory to " + record.target->getName() + " territory \n";
+    case OrderOutcome::Captured:
+        return record.owner->getName() + " won battle against " + record.enemy->getName() + "and takes " + record.target->getName() + " territory\n";
+    case OrderOutcome::Repelled:
+        return record.owner->getName() + " attacks " + record.enemy->getName() + " territory " + record.target->getName() + " and lost.";
+    case OrderOutcome::Bombed:
+        return "Successfully bombed " + record.target->getName() + " territory\n";
+    case OrderOutcome::Blockaded:
+        return "Successfully doubled the number of armies in " + record.target->getName() + " territory and ownership changed to neutral player\n";
+    case OrderOutcome::Airlifted:
+        return "Successfully moved " + to_string(record.armies) + " armies from " + record.source->getName() + " to "
+        + record.target->getName() + " territory via airlift\n";
+    case OrderOutcome::Negotiated:
+        return "Attacking between " + record.owner->getName() + " and " + record.enemy->getName() + " has been prevented until the end of the turn\n";
+    default:
+        return "";
+    }
 }
 string Orders::stringToLog()
 {
     return "Order: " + getName() + ", Effect: " + getEffect();
 }
+//Only the names are logged; the effect's text can be rebuilt from them
+bool Orders::toLogRecord(LogRecord& logRecord)
+{
+    logRecord.event = LogEvent::OrderExecuted;
+    logRecord.outcome = (int)record.outcome;
+    logRecord.armies = record.armies;
+    logRecord.text = getName();
+    if(record.owner != nullptr){
+        logRecord.player = record.owner->getName();
+        logRecord.game = record.owner->getGameEngine()->gameNumber;
+    }
+    if(record.enemy != nullptr) logRecord.otherPlayer = record.enemy->getName();
+    if(record.source != nullptr) logRecord.source = record.source->getName();
+    if(record.target != nullptr) logRecord.target = record.target->getName();
+    if(record.outcome == OrderOutcome::Message) logRecord.detail = record.message;
+    else if(record.outcome == OrderOutcome::Custom) logRecord.detail = effect;
+    //The line break is only there for the game's output
+    if(!logRecord.detail.empty() && logRecord.detail.back() == '\n') logRecord.detail.pop_back();
+    return true;
+}
+
+const char* outcomeName(OrderOutcome outcome) {
+    static const char* names[] = { "None", "Message", "Custom", "Deployed", "Moved", "Captured", "Repelled", "Bombed",
+                                   "Blockaded", "Airlifted", "Negotiated" };
+    int index = (int)outcome;
+    return index >= 0 && index < (int)(sizeof(names) / sizeof(names[0])) ? names[index] : "Unknown";
+}
 void Orders::setEffect(string eff) {
     effect = std::move(eff);
+    record = OrderRecord();
+    record.outcome = OrderOutcome::Custom;
+}
+void Orders::setRecord(const OrderRecord& record) {
+    this->record = record;
+}
+const OrderRecord& Orders::getRecord() const {
+    return record;
 }
 
 //Implemented in other child classes -- Virtual function
@@ -39,16 +110,556 @@ bool Orders::validate() {
 //Implemented in order child classes -- Virtual function
 void Orders::execute() {}
 
-string Orders::getName() {return {};}
+const char* orderTypeName(OrderType type) {
+    static const char* names[] = { "", "Deploy", "Advance", "Bomb", "Blockade", "Airlift", "Negotiate" };
+    int index = (int)type;
+    return index < (int)(sizeof(names) / sizeof(names[0])) ? names[index] : "";
+}
+
+OrderPriority priorityOf(OrderType type) {
+    switch(type){
+    case OrderType::Deploy: return OrderPriority::Deploy;
+    case OrderType::Airlift: return OrderPriority::Airlift;
+    case OrderType::Blockade: return OrderPriority::Blockade;
+    default: return OrderPriority::Other;
+    }
+}
+
+string Orders::getName() {return orderTypeName(type);}
+
+OrderType Orders::getType() const {
+    return type;
+}
+
+Player* Orders::getOrderOwner() {
+    return nullptr;
+}
+
+//Position of a player in the list, -1 if it is not in it (there are only a handful of players)
+static int playerPosition(const vector<Player*>& players, Player* player) {
+    for(int i = 0; i < (int)players.size(); i++){
+        if(players[i] == player) return i;
+    }
+    return -1;
+}
+
+//Position of a territory on the map, -1 for none
+static int32_t territoryPosition(Map* map, Territory* territory) {
+    return map == nullptr || territory == nullptr ? -1 : map->getPosition(territory->getIndex());
+}
 
-Orders::Orders(const Orders &o) = default; //Copy constructor
+//Player at a position in the list, nullptr for none
+static Player* playerAt(const vector<Player*>& players, int position) {
+    return position >= 0 && position < (int)players.size() ? players[position] : nullptr;
+}
+
+//Territory at a position on the map, nullptr for none
+static Territory* territoryAt(Map* map, int position) {
+    return map != nullptr && position >= 0 ? map->getTerritoryAt(position) : nullptr;
+}
+
+OrderData Orders::toData(Map* map, const vector<Player*>& players) {
+    //type, owner, otherPlayer, flags, armies, source, target
+    OrderData data = { type, -1, -1, executed ? OrderData::executed : (uint8_t)0, 0, -1, -1 };
+    data.owner = playerPosition(players, getOrderOwner());
+
+    switch(type){
+    case OrderType::Deploy: {
+        Deploy* deploy = static_cast<Deploy*>(this);
+        data.armies = deploy->getNoOfArmies();
+        data.target = territoryPosition(map, deploy->getTarget());
+        break;
+    }
+    case OrderType::Advance: {
+        Advance* advance = static_cast<Advance*>(this);
+        data.armies = advance->getNoOfArmies();
+        data.source = territoryPosition(map, advance->getSource());
+        data.target = territoryPosition(map, advance->getTarget());
+        if(advance->cannotBeAttacked) data.flags |= OrderData::cannotBeAttacked;
+        break;
+    }
+    case OrderType::Bomb:
+        data.target = territoryPosition(map, static_cast<Bomb*>(this)->getTarget());
+        break;
+    case OrderType::Blockade:
+        data.target = territoryPosition(map, static_cast<Blockade*>(this)->getTarget());
+        break;
+    case OrderType::Airlift: {
+        Airlift* airlift = static_cast<Airlift*>(this);
+        data.armies = airlift->getNoOfArmies();
+        data.source = territoryPosition(map, airlift->getSource());
+        data.target = territoryPosition(map, airlift->getTarget());
+        break;
+    }
+    case OrderType::Negotiate:
+        data.otherPlayer = playerPosition(players, static_cast<Negotiate*>(this)->getOtherPlayer());
+        break;
+    default:
+        break;
+    }
+    return data;
+}
+
+Orders* Orders::fromData(const OrderData& data, GameEngine* game, Map* map, const vector<Player*>& players) {
+    Player* owner = playerAt(players, data.owner);
+    Player* otherPlayer = playerAt(players, data.otherPlayer);
+    Territory* source = territoryAt(map, data.source);
+    Territory* target = territoryAt(map, data.target);
+    OrderArena& arena = game->getOrderArena();
+    Orders* order = nullptr;
+
+    switch(data.type){
+    case OrderType::Deploy:
+        order = arena.create<Deploy>(owner, data.armies, target, game);
+        break;
+    case OrderType::Advance: {
+        Advance* advance = arena.create<Advance>(owner, data.armies, source, target, game);
+        advance->cannotBeAttacked = (data.flags & OrderData::cannotBeAttacked) != 0;
+        order = advance;
+        break;
+    }
+    case OrderType::Bomb:
+        order = arena.create<Bomb>(owner, target, game);
+        break;
+    case OrderType::Blockade:
+        order = arena.create<Blockade>(owner, target, game);
+        break;
+    case OrderType::Airlift:
+        order = arena.create<Airlift>(owner, data.armies, source, target, game);
+        break;
+    case OrderType::Negotiate:
+        order = arena.create<Negotiate>(owner, otherPlayer, game);
+        break;
+    default:
+        return nullptr;
+    }
+
+    order->setExecuted((data.flags & OrderData::executed) != 0);
+    return order;
+}
+
+//Copy constructor, the copy belongs to whoever made it
+Orders::Orders(const Orders &o) : ILoggable(o), Subject(o), executed(o.executed), record(o.record), effect(o.effect), type(o.type) {}
 Orders::~Orders() = default; //Destructor
-Orders& Orders::operator= (const Orders& orders)= default; //Assignment operator overload
+//Assignment operator overload, an order stays owned by whoever made it
+Orders& Orders::operator= (const Orders& orders) {
+    ILoggable::operator=(orders);
+    Subject::operator=(orders);
+    executed = orders.executed;
+    type = orders.type;
+    record = orders.record;
+    effect = orders.effect;
+    return *this;
+}
+
+
+//------------------Rules of each kind of order--------------------
+//The rules work on plain values, so they are shared by the order classes and by Orders::execute(const OrderData&, GameEngine*).
+//The outcome is recorded in, and logged through, 'order'.
+
+//Validate method checking if owner owns target territory and number of armies is valid
+static bool validateDeploy(GameEngine* game, Orders& order, Player* owner, int armies, Territory* target) {
+    if(target== nullptr){
+        NARRATE(game) << "Target territory points to NULL" << endl;
+        return false;
+    }
+    if(order.getExecuted()){
+        NARRATE(game) << "Order already executed" << endl;
+        return false;
+    }
+    //If the target territory does not belong to the player that issued the order, the order is invalid
+    if(owner->ownsTerritory(target) && armies > 0) {
+        NARRATE(game) << "Deploy order is valid" << endl;
+        return true;
+    }
+    NARRATE(game) << "Deploy order is invalid since " + owner->getName() + " does not own " + target->getName() + " territory" <<endl;
+    return false;
+}
+
+//Executing method if valid -- Only printing strings for now
+static void executeDeploy(GameEngine* game, Orders& order, Player* owner, int armies, Territory* target) {
+    if (validateDeploy(game, order, owner, armies, target)) {
+        NARRATE(game) << "Executing the deploy order" << endl;
+        //Moving armies
+        int oldNoOfArmies = target->getNumberOfArmies();
+        int newNoOfArmies = target->getNumberOfArmies() + armies;
+        target->setNumberOfArmies(newNoOfArmies);
+        //Printing message
+        OrderRecord deployed(OrderOutcome::Deployed, owner, nullptr, nullptr, target, armies);
+        deployed.armiesBefore = oldNoOfArmies;
+        order.setRecord(deployed);
+        NARRATE(game) << order.getEffect();
+        order.setExecuted(true);
+    }
+    else {
+        order.setRecord(OrderRecord(owner, "The deploy call failed to execute\n"));
+        NARRATE(game) << order.getEffect();
+    }
+    order.Notify(&order);
+}
+
+//Advance order valid only if target is neighbour of source
+static bool validateAdvance(GameEngine* game, Orders& order, Player* owner, int armies, Territory* source, Territory* target, bool cannotBeAttacked) {
+    if(source== nullptr||target==nullptr){
+        NARRATE(game) << "Either source or target territory points to NULL" << endl;
+        return false;
+    }
+    //If diplomacy card was used last turn
+    if(cannotBeAttacked){
+        NARRATE(game) << "Advance order invalid. Negotiate order was used last turn"
+        << " between " + owner->getName() + "and " + target->getOwner()->getName() << endl;
+        return false;
+    }
+    if(order.getExecuted()){
+        NARRATE(game) << "Order already executed" << endl;
+        return false;
+    }
+    //If the source territory does not belong to the player that issued the order, the order is invalid.
+    if(!owner->ownsTerritory(source)){
+        NARRATE(game) << "Advance order not valid" << endl;
+        NARRATE(game) << "Source territory does not belong to " + owner->getName() << endl;
+        return false;
+    }
+    //If the target territory is not adjacent to the source territory, the order is invalid.
+    bool targetAdj = false;
+    for(auto it: target->getAdjacentTerritories()){
+        if(it == source){
+            targetAdj = true;
+        }
+    }
+    if(!targetAdj){
+        NARRATE(game) << "Advance order not valid" << endl;
+        NARRATE(game) << "Target territory (" + target->getName() + ") not adjacent to source territory(" + source->getName() + ")" << endl;
+        return false;
+    }
+    //If source territory does not have enough armies
+    if(source->getNumberOfArmies() < armies && source->getOwner()->getPlayerStrategy()->strN != source->getOwner()->getPlayerStrategy()->Cheater){
+        NARRATE(game) << "Advance order invalid" << endl;
+        NARRATE(game) << "Not enough armies from source to advance to target territory" << endl;
+        return false;
+    }
+    NARRATE(game) << "Advance order valid" << endl;
+    return true;
+}
+
+//If valid, checking if target is owner territory or enemy territory before executing. 'armies' is updated to the
+//number of armies that actually attacked.
+static void executeAdvance(GameEngine* game, Orders& order, Player* owner, int& armies, Territory* source, Territory* target, bool cannotBeAttacked) {
+    if(validateAdvance(game, order, owner, armies, source, target, cannotBeAttacked)){
+        //If the source and target territory both belong to the player that issued the order, the army units are moved
+        //from the source to the target territory.
+        if(owner->ownsTerritory(target)){
+            NARRATE(game) << "Executing advance order" << endl;
+            //Moving armies from source to target territory
+            int initialSourceArmy = source->getNumberOfArmies();
+            int initialTargetArmy = target->getNumberOfArmies();
+            target->setNumberOfArmies(initialTargetArmy + armies);
+            source->setNumberOfArmies(initialSourceArmy - armies);
+            order.setRecord(OrderRecord(OrderOutcome::Moved, owner, nullptr, source, target, armies));
+            NARRATE(game) << order.getEffect();
+        }
+        // Check if the player is a cheater, if they are, they are granted immediate ownership
+        else if (owner->getPlayerStrategy()->strN == owner->getPlayerStrategy()->Cheater)
+        {
+            //Takes the territory from its owner, so the change of owner is logged with who lost it
+            owner->addOwnedTerritory(target);
+            NARRATE(game) << "\nCheater player " << owner->getName() << " has aquired territory " << target->getName() << endl;
+        }
+        /*If the target territory belongs to another player than the player that issued the advance order, an attack is
+          simulated when the order is executed. An attack is simulated by the following battle simulation
+          mechanism:
+          1.Each attacking army unit involved has 60% chances of killing one defending army. At the same time,
+          each defending army unit has 70% chances of killing one attacking army unit.
+          2.If all the defender's armies are eliminated, the attacker captures the territory. The attacking army units
+          that survived the battle then occupy the conquered territory.
+          3.A player receives a card at the end of his turn if they successfully conquered at least one territory
+          during their turn.*/
+        else{
+            Player* enemy = target->getOwner();
+            for(auto it: enemy->cannotAttack){
+                if(it == owner){
+                    NARRATE(game) << "You cannot attack this player's territory for the remainder of this turn" << endl;
+                    return;
+                }
+            }
+            NARRATE(game) << "Executing advance order" << endl;
+
+            NARRATE(game) << "Attack between " + owner->getName() + " and " + enemy->getName() + " initiated" << endl;
+
+            //Reducing source army
+            if(source->getNumberOfArmies() - armies < 0){
+                //If not enough army is in source territory , use only army in source territory
+                source->setNumberOfArmies(0);
+                armies = source->getNumberOfArmies();
+            }
+            else source->setNumberOfArmies(source->getNumberOfArmies() - armies);
+            //Simulating the battle
+            BattleResult battle = Battle::resolve(armies, target->getNumberOfArmies(), *game->getRandom());
+            int attackingArmy = battle.survivors;
+            if(battle.captured){
+                NARRATE(game) << owner->getName() + " won the battle and has captured territory " + target->getName()
+                << " successfully" << endl;
+                NARRATE(game) << "Number of armies on defeated target territory is now " << attackingArmy <<endl;
+                //Attacker captures territory
+                target->setNumberOfArmies(attackingArmy);
+                //Takes the territory from the enemy, so the change of owner is logged with who lost it
+                owner->addOwnedTerritory(target);
+                //A player receives a card at the end of his turn if
+                //they successfully conquered at least one territory during their turn.
+                if(!owner->receivedCardThisTurn){
+                    owner->getHand()->addHand(game->deck->draw());
+                    owner->receivedCardThisTurn = true;
+                }
+                order.setRecord(OrderRecord(OrderOutcome::Captured, owner, enemy, source, target, armies));
+                order.setExecuted(true);
+                // If a Neutral player is attacked they become an aggressive player
+                if (enemy->getPlayerStrategy()->strN == enemy->getPlayerStrategy()->Neutral)
+                {
+                    enemy->setPlayerStrategy(new AggressivePlayerStrategy(enemy));
+                    NARRATE(game) << "Neutral Player has been attacked! They are now an aggressive player." << endl;
+                }
+                return;
+            }
+            else{
+                //Nothing happens-- Battle lost
+                NARRATE(game) << owner->getName() + " lost the battle" << endl;
+                NARRATE(game) << "Remaining number of armies on enemy territory is " << target->getNumberOfArmies() << endl;
+                order.setRecord(OrderRecord(OrderOutcome::Repelled, owner, enemy, source, target, armies));
+                order.setExecuted(true);
+                // If a Neutral player is attacked they become an aggressive player
+                if (enemy->getPlayerStrategy()->strN == enemy->getPlayerStrategy()->Neutral)
+                {
+                    enemy->setPlayerStrategy(new AggressivePlayerStrategy(enemy));
+                    NARRATE(game) << "Neutral Player has been attacked! They are now an aggressive player." << endl;
+                }
+                return;
+            }
+        }
+    }
+    else{
+        order.setRecord(OrderRecord(owner, "The advance call was not executed since it was invalid\n"));
+        NARRATE(game) << order.getEffect() << endl;
+    }
+    order.Notify(&order);
+}
+
+static bool validateBomb(GameEngine* game, Orders& order, Player* owner, Territory* target) {
+    if(target == nullptr){
+        NARRATE(game) << "Target territory points to NULL" << endl;
+        return false;
+    }
+    if(order.getExecuted()){
+        NARRATE(game) << "Order already executed" << endl;
+        return false;
+    }
+    //If the target belongs to the player that issued the order, the order is invalid.
+    if(owner->ownsTerritory(target)) {
+        NARRATE(game) << "Target belongs to order owner. Cannot bomb it" << endl;
+        return false;
+    }
+    //If the target territory is not adjacent to one of the territory owned by the player issuing the order, then the
+    //order is invalid
+    bool targetAdj = false;
+    for(auto it: target->getAdjacentTerritories()){
+        if(owner->ownsTerritory(it)) targetAdj = true;
+    }
+    if(!targetAdj){
+        NARRATE(game) << "Bomb order invalid --> No territory owned adjacent to target territory " << endl;
+        return false;
+    }
+    NARRATE(game) << "Bomb order valid" << endl;
+    return true;
+
+}
+
+//If valid, checking if target territory is owned by player before executing
+static void executeBomb(GameEngine* game, Orders& order, Player* owner, Territory* target) {
+    if(validateBomb(game, order, owner, target)){
+            NARRATE(game) << "Executing bomb order" << endl;
+            //Reducing enemy army by half
+            target->setNumberOfArmies(target->getNumberOfArmies()/2);
+            order.setRecord(OrderRecord(OrderOutcome::Bombed, owner, nullptr, nullptr, target, 0));
+            NARRATE(game) << order.getEffect();
+            order.setExecuted(true);
+            if (target->getOwner()->getPlayerStrategy()->strN == target->getOwner()->getPlayerStrategy()->Neutral)
+            {
+                target->getOwner()->setPlayerStrategy(new AggressivePlayerStrategy(target->getOwner()));
+                NARRATE(game) << "Neutral Player has been attacked! They are now an aggressive player." << endl;
+            }
+            
+    }
+    else{
+        order.setRecord(OrderRecord(owner, "The bomb order was not executed since it was invalid\n"));
+        NARRATE(game) << order.getEffect() << endl;
+    }
+    order.Notify(&order);
+}
 
+/*The blockade order can only be created by playing the blockade card
+  A blockade order targets a territory that belongs to the player issuing the order. Its effect is to
+  double the number of armies on the territory and to transfer the ownership of the territory to the Neutral player.
+  The blockade order can only be created by playing the blockade card.*/
+static bool validateBlockade(GameEngine* game, Orders& order, Player* owner, Territory* target) {
+    if(target== nullptr){
+        NARRATE(game) << "Target territory points to NULL" << endl;
+        return false;
+    }
+    if(order.getExecuted()){
+        NARRATE(game) << "Order already executed" << endl;
+        return false;
+    }
+    //If the target territory belongs to an enemy player, the order is declared invalid.
+    if(!owner->ownsTerritory(target)){
+        NARRATE(game) << "Order invalid -- Target territory belongs to enemy player" << endl;
+        return false;
+    }
+    return true;
+}
+
+//Executing order if valid
+static void executeBlockade(GameEngine* game, Orders& order, Player* owner, Territory* target) {
+    if(validateBlockade(game, order, owner, target)){
+        NARRATE(game) << "Executing blockade order" << endl;
+        //Doubling number of armies and transferring ownership
+        target->setNumberOfArmies(target->getNumberOfArmies() * 2);
+        //Ownership of the territory is transferred to the Neutral player, which must be created if it
+        //does not already exist.
+        game->getNeutralPlayer()->addOwnedTerritory(target);
+        owner->removeOwnedTerritory(target);
+        order.setRecord(OrderRecord(OrderOutcome::Blockaded, owner, nullptr, nullptr, target, 0));
+        NARRATE(game) << order.getEffect();
+        order.setExecuted(true);
+    }
+    else{
+        order.setRecord(OrderRecord(owner, "The blockade order was not executed\n"));
+        NARRATE(game) << order.getEffect() << endl;
+    }
+    order.Notify(&order);
+}
+
+//Airlift order valid if source territory is owned by the owner
+static bool validateAirlift(GameEngine* game, Orders& order, Player* owner, Territory* source, Territory* target) {
+    if(target== nullptr||source== nullptr){
+        NARRATE(game) << "Either target territory or source territory points to NULL" << endl;
+        return false;
+    }
+    if(order.getExecuted()){
+        NARRATE(game) << "Order already executed" << endl;
+        return false;
+    }
+    if(!owner->ownsTerritory(source)){
+        NARRATE(game) << "Airlift order not valid -- " + owner->getName() +
+        " does not own " + source->getName() + "(source) territory" << endl;
+        return false;
+    }
+    else if(!owner->ownsTerritory(target)){
+        NARRATE(game) << "Airlift order not valid -- " + owner->getName() +
+        " does not own " + target->getName() + "(target) territory" << endl;
+        return false;
+    }
+    NARRATE(game) << "Airlift order valid" << endl;
+    return true;
+}
+
+//Airlift order is executed if valid
+static void executeAirlift(GameEngine* game, Orders& order, Player* owner, int armies, Territory* source, Territory* target) {
+    if(validateAirlift(game, order, owner, source, target)){
+        NARRATE(game) << "Executing Airlift order" << endl;
+        //Moving armies
+        target->setNumberOfArmies(target->getNumberOfArmies() + armies);
+        source->setNumberOfArmies(source->getNumberOfArmies() - armies);
+        order.setRecord(OrderRecord(OrderOutcome::Airlifted, owner, nullptr, source, target, armies));
+        NARRATE(game) << order.getEffect();
+        order.setExecuted(true);
+    }
+    else{
+        order.setRecord(OrderRecord(owner, "Airlift order has not been executed\n"));
+        NARRATE(game) << order.getEffect() << endl;
+    }
+    order.Notify(&order);
+}
+
+/*A negotiate order targets an enemy player. It results in the target player and the player issuing
+  the order to not be able to successfully attack each others’ territories for the remainder of the turn. The negotiate
+  order can only be created by playing the diplomacy card.*/
+static bool validateNegotiate(GameEngine* game, Orders& order, Player* owner, Player* otherPlayer) {
+    if(otherPlayer== nullptr){
+        NARRATE(game) << "Target Player points to NULL" << endl;
+    }
+    if(order.getExecuted()){
+        NARRATE(game) << "Order already executed" << endl;
+        return false;
+    }
+    //If the target is the player issuing the order, then the order is invalid.
+    if(owner == otherPlayer){
+        NARRATE(game) << "You cannot negotiate with yourself" << endl;
+        return false;
+    }
+    NARRATE(game) << "Negotiate order valid" << endl;
+    return true;
+}
+
+static void executeNegotiate(GameEngine* game, Orders& order, Player* owner, Player* otherPlayer) {
+    //If the target is an enemy player, then the effect is that any attack that may be declared between territories
+    //of the player issuing the negotiate order and the target player will result in an invalid order.
+    if(validateNegotiate(game, order, owner, otherPlayer)){
+        NARRATE(game) << "Executing Negotiate order" << endl;
+        owner->cannotAttack.push_back(otherPlayer);
+        otherPlayer->cannotAttack.push_back(owner);
+
+        order.setRecord(OrderRecord(OrderOutcome::Negotiated, owner, otherPlayer, nullptr, nullptr, 0));
+        NARRATE(game) << order.getEffect();
+        order.setExecuted(true);
+    }
+    else{
+        order.setRecord(OrderRecord(owner, "Negotiate order has not been executed\n"));
+        NARRATE(game) << order.getEffect() << endl;
+    }
+    order.Notify(&order);
+}
+
+//Runs the rules with a switch on the type: the order is never turned back into an object of its class, the base class only
+//holds its outcome while it is logged
+void Orders::execute(const OrderData& data, GameEngine* game) {
+    Map* map = game->getMap();
+    Player* owner = playerAt(game->players, data.owner);
+    Territory* source = territoryAt(map, data.source);
+    Territory* target = territoryAt(map, data.target);
+    int armies = data.armies;
+
+    Orders order;
+    order.type = data.type;
+    order.executed = (data.flags & OrderData::executed) != 0;
+    order.Attach(game->_observer);
+
+    switch(data.type){
+    case OrderType::Deploy:
+        executeDeploy(game, order, owner, armies, target);
+        break;
+    case OrderType::Advance:
+        executeAdvance(game, order, owner, armies, source, target, (data.flags & OrderData::cannotBeAttacked) != 0);
+        break;
+    case OrderType::Bomb:
+        executeBomb(game, order, owner, target);
+        break;
+    case OrderType::Blockade:
+        executeBlockade(game, order, owner, target);
+        break;
+    case OrderType::Airlift:
+        executeAirlift(game, order, owner, armies, source, target);
+        break;
+    case OrderType::Negotiate:
+        executeNegotiate(game, order, owner, playerAt(game->players, data.otherPlayer));
+        break;
+    default:
+        break;
+    }
+}
 
 //------------------Deploy class--------------------
 
 Deploy::Deploy(Player* orderOwner,int noOfArmies, Territory* target, GameEngine* game) {
+    this->type = OrderType::Deploy;
     this->game = game;
     this->Attach(game->_observer);
     this->orderOwner = orderOwner;
@@ -72,7 +683,9 @@ Territory* Deploy::getTarget(){
     return this->target;
 }
 
-string Deploy::getName() {return name;}
+Player* Deploy::getOrderOwner() {
+    return orderOwner;
+}
 
 //Stream insertion operator overload
 ostream& operator <<(ostream &strm, Deploy& deploy){
@@ -96,48 +709,18 @@ Deploy& Deploy::operator = (const Deploy& deploy){
     return *this;
 }
 
-//Validate method checking if orderOwner owns target territory and number of armies is valid
+//See validateDeploy and executeDeploy, also run by Orders::execute(const OrderData&, GameEngine*)
 bool Deploy::validate() {
-    if(target== nullptr){
-        cout << "Target territory points to NULL" << endl;
-        return false;
-    }
-    if(getExecuted()){
-        cout << "Order already executed" << endl;
-        return false;
-    }
-    //If the target territory does not belong to the player that issued the order, the order is invalid
-    if(orderOwner->ownsTerritory(getTarget()) && getNoOfArmies() > 0) {
-        cout << "Deploy order is valid" << endl;
-        return true;
-    }
-    cout << "Deploy order is invalid since " + orderOwner->getName() + " does not own " + target->getName() + " territory" <<endl;
-    return false;
+    return validateDeploy(game, *this, orderOwner, noOfArmies, target);
 }
 
-//Executing method if valid -- Only printing strings for now
 void Deploy::execute() {
-    if (validate()) {
-        cout << "Executing the deploy order" << endl;
-        //Moving armies
-        int oldNoOfArmies = getTarget()->getNumberOfArmies();
-        int newNoOfArmies = getTarget()->getNumberOfArmies() + noOfArmies;
-        getTarget()->setNumberOfArmies(newNoOfArmies);
-        //Printing message
-        setEffect(orderOwner->getName() + " has deployed " + to_string(getNoOfArmies()) +
-        " armies to territory " + target->getName() +". Old army count = " + to_string(oldNoOfArmies) + ". New army count = " + to_string(getTarget()->getNumberOfArmies())
-         + "\n");
-        cout << getEffect();
-        setExecuted(true);
-    }
-    else {
-        setEffect("The deploy call failed to execute\n");
-        cout << getEffect();
-    }
-    Notify(this);
+    executeDeploy(game, *this, orderOwner, noOfArmies, target);
 }
+
 //Copy constructor
 Deploy::Deploy(const Deploy &deploy){
+    this->type = OrderType::Deploy;
     //Intentionally shallow copying data members of deploy class since no new members are being created
     this->game = deploy.game;
     this->Attach(deploy.game->_observer);
@@ -157,6 +740,7 @@ Deploy::~Deploy() {
 //------------------------------Advance class---------------------
 
 Advance::Advance(Player* orderOwner,int n, Territory *s, Territory *t, GameEngine* game) {
+    this->type = OrderType::Advance;
     this->game = game;
     this->Attach(game->_observer);
     this->orderOwner = orderOwner;
@@ -178,6 +762,10 @@ Territory* Advance::getTarget() {
     return target;
 }
 
+Player* Advance::getOrderOwner() {
+    return orderOwner;
+}
+
 void Advance::setTarget(Territory *t) {
     target = t;
 }
@@ -189,8 +777,6 @@ void Advance::setSource(Territory *s) {
     source = s;
 }
 
-string Advance::getName() {return name;}
-
 //Stream insertion operator overload
 ostream& operator <<(ostream &strm, Advance& advance){
     string s1 = "Advance order\n";
@@ -200,161 +786,15 @@ ostream& operator <<(ostream &strm, Advance& advance){
     else return strm << s1;
 }
 
-//Advance order valid only if target is neighbour of source
+//See validateAdvance and executeAdvance, also run by Orders::execute(const OrderData&, GameEngine*)
 bool Advance::validate() {
-    if(source== nullptr||target==nullptr){
-        cout << "Either source or target territory points to NULL" << endl;
-        return false;
-    }
-    //If diplomacy card was used last turn
-    if(cannotBeAttacked){
-        cout << "Advance order invalid. Negotiate order was used last turn"
-        << " between " + orderOwner->getName() + "and " + target->getOwner()->getName() << endl;
-        return false;
-    }
-    if(getExecuted()){
-        cout << "Order already executed" << endl;
-        return false;
-    }
-    //If the source territory does not belong to the player that issued the order, the order is invalid.
-    if(!orderOwner->ownsTerritory(source)){
-        cout << "Advance order not valid" << endl;
-        cout << "Source territory does not belong to " + orderOwner->getName() << endl;
-        return false;
-    }
-    //If the target territory is not adjacent to the source territory, the order is invalid.
-    bool targetAdj = false;
-    for(auto it: getTarget()->getAdjacentTerritories()){
-        if(it == source){
-            targetAdj = true;
-        }
-    }
-    if(!targetAdj){
-        cout << "Advance order not valid" << endl;
-        cout << "Target territory (" + getTarget()->getName() + ") not adjacent to source territory(" + source->getName() + ")" << endl;
-        return false;
-    }
-    //If source territory does not have enough armies
-    if(source->getNumberOfArmies() < getNoOfArmies() && source->getOwner()->getPlayerStrategy()->strN != source->getOwner()->getPlayerStrategy()->Cheater){
-        cout << "Advance order invalid" << endl;
-        cout << "Not enough armies from source to advance to target territory" << endl;
-        return false;
-    }
-    cout << "Advance order valid" << endl;
-    return true;
+    return validateAdvance(game, *this, orderOwner, noOfArmies, source, target, cannotBeAttacked);
 }
-//If valid, checking if target is owner territory or enemy territory before executing
-void Advance::execute() {
-    if(validate()){
-        //If the source and target territory both belong to the player that issued the order, the army units are moved
-        //from the source to the target territory.
-        if(orderOwner->ownsTerritory(target)){
-            cout << "Executing advance order" << endl;
-            //Moving armies from source to target territory
-            int initialSourceArmy = source->getNumberOfArmies();
-            int initialTargetArmy = target->getNumberOfArmies();
-            target->setNumberOfArmies(initialTargetArmy + noOfArmies);
-            source->setNumberOfArmies(initialSourceArmy - noOfArmies);
-            setEffect(orderOwner->getName() + " has moved " + to_string(getNoOfArmies()) + " armies from " + source->getName()
-            + " territory to " + target->getName() + " territory \n");
-            cout << getEffect();
-        }
-        // Check if the player is a cheater, if they are, they are granted immediate ownership
-        else if (orderOwner->getPlayerStrategy()->strN == orderOwner->getPlayerStrategy()->Cheater)
-        {
-            target->getOwner()->removeOwnedTerritory(target);
-            orderOwner->addOwnedTerritory(target);
-            cout << "\nCheater player " << orderOwner->getName() << " has aquired territory " << target->getName() << endl;
-        }
-        /*If the target territory belongs to another player than the player that issued the advance order, an attack is
-          simulated when the order is executed. An attack is simulated by the following battle simulation
-          mechanism:
-          1.Each attacking army unit involved has 60% chances of killing one defending army. At the same time,
-          each defending army unit has 70% chances of killing one attacking army unit.
-          2.If all the defender's armies are eliminated, the attacker captures the territory. The attacking army units
-          that survived the battle then occupy the conquered territory.
-          3.A player receives a card at the end of his turn if they successfully conquered at least one territory
-          during their turn.*/
-        else{
-            Player* enemy = target->getOwner();
-            for(auto it: enemy->cannotAttack){
-                if(it == orderOwner){
-                    cout << "You cannot attack this player's territory for the remainder of this turn" << endl;
-                    return;
-                }
-            }
-            cout << "Executing advance order" << endl;
 
-            cout << "Attack between " + orderOwner->getName() + " and " + enemy->getName() + " initiated" << endl;
-
-            //Random int from 1 to 10
-            int randNumber = rand() % 10 + 1;
-            //Reducing source army
-            if(source->getNumberOfArmies() - noOfArmies < 0){
-                //If not enough army is in source territory , use only army in source territory
-                source->setNumberOfArmies(0);
-                noOfArmies = source->getNumberOfArmies();
-            }
-            else source->setNumberOfArmies(source->getNumberOfArmies() - noOfArmies);
-            int attackingArmy = noOfArmies;
-            int defendingArmy = target->getNumberOfArmies();
-            for(int i = 0;;i++){
-                if(randNumber <= 6){
-                    defendingArmy--;
-                }
-                if(randNumber <=7){
-                    attackingArmy--;
-                }
-                if(defendingArmy <= 0){
-                    cout << orderOwner->getName() + " won the battle and has captured territory " + target->getName()
-                    << " successfully" << endl;
-                    cout << "Number of armies on defeated target territory is now " << attackingArmy <<endl;
-                    //Attacker captures territory
-                    target->setNumberOfArmies(attackingArmy);
-                    target->getOwner()->removeOwnedTerritory(target);
-                    orderOwner->addOwnedTerritory(target);
-                    //A player receives a card at the end of his turn if
-                    //they successfully conquered at least one territory during their turn.
-                    if(!orderOwner->receivedCardThisTurn){
-                        orderOwner->getHand()->addHand(game->deck->draw());
-                        orderOwner->receivedCardThisTurn = true;
-                    }
-                    setEffect(orderOwner->getName() + " won battle against "
-                    + enemy->getName() + "and takes " + target->getName() + " territory\n");
-                    setExecuted(true);
-                    // If a Neutral player is attacked they become an aggressive player
-                    if (enemy->getPlayerStrategy()->strN == enemy->getPlayerStrategy()->Neutral)
-                    {
-                        enemy->setPlayerStrategy(new AggressivePlayerStrategy(enemy));
-                        cout << "Neutral Player has been attacked! They are now an aggressive player." << endl;
-                    }
-                    return;
-                }
-                if(attackingArmy <= 0){
-                    //Nothing happens-- Battle lost
-                    cout << orderOwner->getName() + " lost the battle" << endl;
-                    cout << "Remaining number of armies on enemy territory is " << target->getNumberOfArmies() << endl;
-                    setEffect(orderOwner->getName() + " attacks " + enemy->getName() + " territory " +
-                    target->getName() + " and lost.");
-                    setExecuted(true);
-                    // If a Neutral player is attacked they become an aggressive player
-                    if (enemy->getPlayerStrategy()->strN == enemy->getPlayerStrategy()->Neutral)
-                    {
-                        enemy->setPlayerStrategy(new AggressivePlayerStrategy(enemy));
-                        cout << "Neutral Player has been attacked! They are now an aggressive player." << endl;
-                    }
-                    return;
-                }
-                randNumber = rand() % 10 + 1;
-            }
-        }
-    }
-    else{
-        setEffect("The advance call was not executed since it was invalid\n");
-        cout << getEffect() << endl;
-    }
-    Notify(this);
+void Advance::execute() {
+    executeAdvance(game, *this, orderOwner, noOfArmies, source, target, cannotBeAttacked);
 }
+
 //Assignment operator overload
 //Intentionally shallow copying data members of deploy class since no new members are being created
 Advance &Advance::operator=(const Advance &advance) {
@@ -371,6 +811,7 @@ Advance &Advance::operator=(const Advance &advance) {
 
 //Intentionally shallow copying data members of deploy class since no new members are being created
 Advance::Advance(const Advance &advance){
+    this->type = OrderType::Advance;
     this->game = advance.game;
     this->Attach(advance.game->_observer);
     this->orderOwner = advance.orderOwner;
@@ -391,6 +832,7 @@ Advance::~Advance() {
 //------------------------------Bomb class---------------------
 
 Bomb::Bomb(Player* orderOwner, Territory *target, GameEngine* game) {
+    this->type = OrderType::Bomb;
     this->game = game;
     this->Attach(game->_observer);
     this->orderOwner = orderOwner;
@@ -401,12 +843,14 @@ Territory* Bomb::getTarget() {
     return target;
 }
 
+Player* Bomb::getOrderOwner() {
+    return orderOwner;
+}
+
 void Bomb::setTarget(Territory *t) {
     target = t;
 }
 
-string Bomb::getName() {return name;}
-
 //Stream insertion operator overload
 ostream& operator <<(ostream &strm, Bomb& bomb){
     string s1 = "Bomb order\n";
@@ -416,55 +860,13 @@ ostream& operator <<(ostream &strm, Bomb& bomb){
     else return strm << s1;
 }
 
+//See validateBomb and executeBomb, also run by Orders::execute(const OrderData&, GameEngine*)
 bool Bomb::validate() {
-    if(target == nullptr){
-        cout << "Target territory points to NULL" << endl;
-        return false;
-    }
-    if(getExecuted()){
-        cout << "Order already executed" << endl;
-        return false;
-    }
-    //If the target belongs to the player that issued the order, the order is invalid.
-    if(orderOwner->ownsTerritory(target)) {
-        cout << "Target belongs to order owner. Cannot bomb it" << endl;
-        return false;
-    }
-    //If the target territory is not adjacent to one of the territory owned by the player issuing the order, then the
-    //order is invalid
-    bool targetAdj = false;
-    for(auto it: target->getAdjacentTerritories()){
-        if(orderOwner->ownsTerritory(it)) targetAdj = true;
-    }
-    if(!targetAdj){
-        cout << "Bomb order invalid --> No territory owned adjacent to target territory " << endl;
-        return false;
-    }
-    cout << "Bomb order valid" << endl;
-    return true;
-
+    return validateBomb(game, *this, orderOwner, target);
 }
-//If valid, checking if target territory is owned by player before executing
+
 void Bomb::execute() {
-    if(validate()){
-            cout << "Executing bomb order" << endl;
-            //Reducing enemy army by half
-            target->setNumberOfArmies(target->getNumberOfArmies()/2);
-            setEffect("Successfully bombed " + target->getName() + " territory\n");
-            cout << getEffect();
-            setExecuted(true);
-            if (target->getOwner()->getPlayerStrategy()->strN == target->getOwner()->getPlayerStrategy()->Neutral)
-            {
-                target->getOwner()->setPlayerStrategy(new AggressivePlayerStrategy(target->getOwner()));
-                cout << "Neutral Player has been attacked! They are now an aggressive player." << endl;
-            }
-            
-    }
-    else{
-        setEffect("The bomb order was not executed since it was invalid\n");
-        cout << getEffect() << endl;
-    }
-    Notify(this);
+    executeBomb(game, *this, orderOwner, target);
 }
 
 //Assignment operator overload
@@ -479,6 +881,7 @@ Bomb &Bomb::operator=(const Bomb &bomb) {
 
 //Intentionally shallow copying data members of deploy class since no new members are being created
 Bomb::Bomb(const Bomb &bomb) {
+    this->type = OrderType::Bomb;
     this->game = bomb.game;
     this->Attach(bomb.game->_observer);
     this->orderOwner = bomb.orderOwner;
@@ -496,6 +899,7 @@ Bomb::~Bomb() {
 //------------------------------Blockade class---------------------
 
 Blockade::Blockade(Player* orderOwner, Territory *target,GameEngine* gameEngine1) {
+    this->type = OrderType::Blockade;
     this->game = gameEngine1;
     this->Attach(gameEngine1->_observer);
     this->orderOwner = orderOwner;
@@ -511,7 +915,9 @@ Territory* Blockade::getTarget() {
     return target;
 }
 
-string Blockade::getName() {return name;}
+Player* Blockade::getOrderOwner() {
+    return orderOwner;
+}
 
 //Stream insertion operator overload
 ostream& operator <<(ostream &strm, Blockade& blockade){
@@ -522,47 +928,13 @@ ostream& operator <<(ostream &strm, Blockade& blockade){
     else return strm << s1;
 }
 
-/*The blockade order can only be created by playing the blockade card
-  A blockade order targets a territory that belongs to the player issuing the order. Its effect is to
-  double the number of armies on the territory and to transfer the ownership of the territory to the Neutral player.
-  The blockade order can only be created by playing the blockade card.*/
+//See validateBlockade and executeBlockade, also run by Orders::execute(const OrderData&, GameEngine*)
 bool Blockade::validate() {
-    if(getTarget()== nullptr){
-        cout << "Target territory points to NULL" << endl;
-        return false;
-    }
-    if(getExecuted()){
-        cout << "Order already executed" << endl;
-        return false;
-    }
-    //If the target territory belongs to an enemy player, the order is declared invalid.
-    if(!orderOwner->ownsTerritory(target)){
-        cout << "Order invalid -- Target territory belongs to enemy player" << endl;
-        return false;
-    }
-    return true;
+    return validateBlockade(game, *this, orderOwner, target);
 }
 
-//Executing order if valid
 void Blockade::execute() {
-    if(validate()){
-        cout << "Executing blockade order" << endl;
-        //Doubling number of armies and transferring ownership
-        target->setNumberOfArmies(target->getNumberOfArmies() * 2);
-        //Ownership of the territory is transferred to the Neutral player, which must be created if it
-        //does not already exist.
-        game->getNeutralPlayer()->addOwnedTerritory(target);
-        orderOwner->removeOwnedTerritory(target);
-        setEffect("Successfully doubled the number of armies in " + target->getName() + " territory" +
-        " and ownership changed to neutral player\n");
-        cout << getEffect();
-        setExecuted(true);
-    }
-    else{
-        setEffect("The blockade order was not executed\n");
-        cout << getEffect() << endl;
-    }
-    Notify(this);
+    executeBlockade(game, *this, orderOwner, target);
 }
 
 //Assignment operator overload
@@ -579,6 +951,7 @@ Blockade &Blockade::operator=(const Blockade &blockade) {
 
 //Intentionally shallow copying data members of deploy class since no new members are being created
 Blockade::Blockade(const Blockade &blockade) {
+    this->type = OrderType::Blockade;
     this->game = blockade.game;
     this->Attach(blockade.game->_observer);
     this->orderOwner = blockade.orderOwner;
@@ -597,6 +970,7 @@ Blockade::~Blockade() {
 //------------------------------Airlift class---------------------
 
 Airlift::Airlift(Player* orderOwner,int n, Territory *s, Territory *t, GameEngine* game) {
+    this->type = OrderType::Airlift;
     this->game = game;
     this->Attach(game->_observer);
     this->orderOwner = orderOwner;
@@ -617,6 +991,10 @@ Territory* Airlift::getTarget() {
     return target;
 }
 
+Player* Airlift::getOrderOwner() {
+    return orderOwner;
+}
+
 void Airlift::setTarget(Territory *t) {
     target = t;
 }
@@ -628,8 +1006,6 @@ void Airlift::setSource(Territory *s) {
     source = s;
 }
 
-string Airlift::getName() {return name;}
-
 //Stream insertion operator overload
 ostream& operator <<(ostream &strm, Airlift& airlift){
     string s1 = "Airlift order\n";
@@ -638,47 +1014,13 @@ ostream& operator <<(ostream &strm, Airlift& airlift){
     }
     else return strm << s1;
 }
-//Airlift order valid if source territory is owned by OrderOwner
+//See validateAirlift and executeAirlift, also run by Orders::execute(const OrderData&, GameEngine*)
 bool Airlift::validate() {
-    if(getTarget()== nullptr||getSource()== nullptr){
-        cout << "Either target territory or source territory points to NULL" << endl;
-        return false;
-    }
-    if(getExecuted()){
-        cout << "Order already executed" << endl;
-        return false;
-    }
-    if(!orderOwner->ownsTerritory(source)){
-        cout << "Airlift order not valid -- " + orderOwner->getName() +
-        " does not own " + source->getName() + "(source) territory" << endl;
-        return false;
-    }
-    else if(!orderOwner->ownsTerritory(target)){
-        cout << "Airlift order not valid -- " + orderOwner->getName() +
-        " does not own " + target->getName() + "(target) territory" << endl;
-        return false;
-    }
-    cout << "Airlift order valid" << endl;
-    return true;
+    return validateAirlift(game, *this, orderOwner, source, target);
 }
 
-//Airlift order is executed if valid
 void Airlift::execute() {
-    if(validate()){
-        cout << "Executing Airlift order" << endl;
-        //Moving armies
-        target->setNumberOfArmies(target->getNumberOfArmies() + noOfArmies);
-        source->setNumberOfArmies(source->getNumberOfArmies() - noOfArmies);
-        setEffect("Successfully moved " + to_string(getNoOfArmies()) + " armies from " +
-        source->getName() + " to " + target->getName() + " territory via airlift\n");
-        cout << getEffect();
-        setExecuted(true);
-    }
-    else{
-        setEffect("Airlift order has not been executed\n");
-        cout << getEffect() << endl;
-    }
-    Notify(this);
+    executeAirlift(game, *this, orderOwner, noOfArmies, source, target);
 }
 
 //Assignment operator overload
@@ -697,6 +1039,7 @@ Airlift &Airlift::operator=(const Airlift &airlift) {
 
 //Intentionally shallow copying data members of deploy class since no new members are being created
 Airlift::Airlift(const Airlift &airlift) {
+    this->type = OrderType::Airlift;
     this->game = airlift.game;
     this->Attach(airlift.game->_observer);
     this->orderOwner = airlift.orderOwner;
@@ -717,6 +1060,7 @@ Airlift::~Airlift() {
 //--------------------------Negotiate class------------------
 
 Negotiate::Negotiate(Player *orderOwner,Player* otherPlayer, GameEngine* game){
+    this->type = OrderType::Negotiate;
     this->game = game;
     this->Attach(game->_observer);
     this->orderOwner = orderOwner;
@@ -733,49 +1077,18 @@ ostream& operator <<(ostream &strm, Negotiate& negotiate){
     else return strm << s1;
 }
 
-/*A negotiate order targets an enemy player. It results in the target player and the player issuing
-  the order to not be able to successfully attack each others’ territories for the remainder of the turn. The negotiate
-  order can only be created by playing the diplomacy card.*/
+//See validateNegotiate and executeNegotiate, also run by Orders::execute(const OrderData&, GameEngine*)
 bool Negotiate::validate() {
-    if(otherPlayer== nullptr){
-        cout << "Target Player points to NULL" << endl;
-    }
-    if(getExecuted()){
-        cout << "Order already executed" << endl;
-        return false;
-    }
-    //If the target is the player issuing the order, then the order is invalid.
-    if(orderOwner == otherPlayer){
-        cout << "You cannot negotiate with yourself" << endl;
-        return false;
-    }
-    cout << "Negotiate order valid" << endl;
-    return true;
+    return validateNegotiate(game, *this, orderOwner, otherPlayer);
 }
 
-/*A negotiate order targets an enemy player. It results in the target player and the player issuing
-  the order to not be able to successfully attack each others’ territories for the remainder of the turn. The negotiate
-  order can only be created by playing the diplomacy card.*/
 void Negotiate::execute() {
-    //If the target is an enemy player, then the effect is that any attack that may be declared between territories
-    //of the player issuing the negotiate order and the target player will result in an invalid order.
-    if(validate()){
-        cout << "Executing Negotiate order" << endl;
-        orderOwner->cannotAttack.push_back(otherPlayer);
-        otherPlayer->cannotAttack.push_back(orderOwner);
-
-        setEffect("Attacking between " + orderOwner->getName() + " and " + otherPlayer->getName() + " has been prevented until the end of the turn\n");
-        cout << getEffect();
-        setExecuted(true);
-    }
-    else{
-        setEffect("Negotiate order has not been executed\n");
-        cout << getEffect() << endl;
-    }
-    Notify(this);
+    executeNegotiate(game, *this, orderOwner, otherPlayer);
 }
+
 //Intentionally shallow copying data members of deploy class since no new members are being created
 Negotiate::Negotiate(const Negotiate &negotiate){
+    this->type = OrderType::Negotiate;
     this->game = negotiate.game;
     this->Attach(negotiate.game->_observer);
     this->orderOwner = negotiate.orderOwner;
@@ -801,7 +1114,9 @@ Negotiate &Negotiate::operator=(const Negotiate &negotiate) {
     return *this;
 }
 
-string Negotiate::getName() {return name;}
+Player* Negotiate::getOtherPlayer() {return otherPlayer;}
+
+Player* Negotiate::getOrderOwner() {return orderOwner;}
 
 
 
@@ -819,20 +1134,20 @@ void OrdersList::setOrdersList(vector<Orders*>& orderList) {
 
 //Removing order by index --> invalid indexes checked
 bool OrdersList::removeOrder(int index) {
-    cout << "Trying to remove order " + ordersList.at(index)->getName() + " from the list" << endl;
+    NARRATE(ordersListOwner->getGameEngine()) << "Trying to remove order " + ordersList.at(index)->getName() + " from the list" << endl;
     if(index < 0 || index >= ordersList.size()){
-        cout << "Index specified not in range of vector size" << endl;
+        NARRATE(ordersListOwner->getGameEngine()) << "Index specified not in range of vector size" << endl;
         return false;
     }
     //If last element has to be removed
     else if(index +1 == ordersList.size()){
         ordersList.pop_back();
-        cout << "Last order in list removed" << endl;
+        NARRATE(ordersListOwner->getGameEngine()) << "Last order in list removed" << endl;
         return true;
     }
     else{
         ordersList.erase(ordersList.begin()+index);
-        cout << "Order successfully removed" << endl;
+        NARRATE(ordersListOwner->getGameEngine()) << "Order successfully removed" << endl;
         return true;
     }
 }
@@ -840,9 +1155,9 @@ bool OrdersList::removeOrder(int index) {
 
 //Moving orders from one index to another using the rotate algorithm
 bool OrdersList::move(int i, int j) {
-    cout << "Trying to move order " << ordersList.at(i)->getName() << " from position " << i << " to position " << j <<  " in the list " << endl;
+    NARRATE(ordersListOwner->getGameEngine()) << "Trying to move order " << ordersList.at(i)->getName() << " from position " << i << " to position " << j <<  " in the list " << endl;
     if(i < 0 || i >= ordersList.size() || j < 0 || j >= ordersList.size()) {
-        cout << "Indexes specified not in range of vector size" << endl;
+        NARRATE(ordersListOwner->getGameEngine()) << "Indexes specified not in range of vector size" << endl;
         return false;
     }
     else{
@@ -852,18 +1167,46 @@ bool OrdersList::move(int i, int j) {
         else{
             rotate(ordersList.begin() + i, ordersList.begin() + 1, ordersList.begin() + j + 1);
         }
-        cout << "Order position successfully switched" << endl << endl;
+        NARRATE(ordersListOwner->getGameEngine()) << "Order position successfully switched" << endl << endl;
         return true;
     }
 }
 
-//Destructor for ordersList, deleting each order pointer before clearing the vector
+//Destructor for ordersList, deleting each order it owns before clearing the vector
 OrdersList::~OrdersList() {
+    clear();
+    this->Detach();
+}
+
+void OrdersList::clear() {
     for(auto it : ordersList){
-        delete it;
+        if(!it->isPooled()) delete it;
     }
     ordersList.clear();
-    this->Detach();
+    for(int i = 0; i < numOrderPriorities; i++){
+        lanes[i].clear();
+        nextIndex[i] = 0;
+    }
+}
+
+void OrdersList::queueForExecution() {
+    GameEngine* game = ordersListOwner->getGameEngine();
+    for(auto it : ordersList){
+        lanes[(int)priorityOf(it->getType())].push_back(it->toData(game->getMap(), game->players));
+        if(!it->isPooled()) delete it;
+    }
+    ordersList.clear();
+}
+
+const OrderData* OrdersList::next(OrderPriority priority) {
+    int i = (int)priority;
+    if(nextIndex[i] == lanes[i].size()) return nullptr;
+    executedCount[i]++;
+    return &lanes[i][nextIndex[i]++];
+}
+
+long long OrdersList::getExecutedCount(OrderPriority priority) const {
+    return executedCount[(int)priority];
 }
 //New order is created and put in the list but the data members of the order are still a shallow copy since no new members needed to be created
 OrdersList::OrdersList(const OrdersList& ol){
@@ -905,6 +1248,14 @@ string OrdersList::stringToLog()
     out += " into the list.";
     return out;
 }
+bool OrdersList::toLogRecord(LogRecord& logRecord)
+{
+    logRecord.event = LogEvent::OrderIssued;
+    logRecord.player = ordersListOwner->getName();
+    logRecord.game = ordersListOwner->getGameEngine()->gameNumber;
+    logRecord.text = ordersList.back()->getName();
+    return true;
+}
 //End of OrdersList class implementation
 
 /*Neutral player pointer return method*/
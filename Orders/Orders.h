@@ -1,12 +1,14 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <cstdint>
 
 #include "../Map/Map.h"
 #include "../Cards/Cards.h"
 #include "../Game Engine/GameEngine.h"
 #include "../Player/Player.h"
 #include "../LoggingObserver/LoggingObserver.h"
+#include "OrderArena.h"
 
 using namespace std;
 
@@ -15,30 +17,105 @@ class Territory;
 class Deck;
 class GameEngine;
 
+//----------------------OrderRecord------------------
+//What executing an order did
+enum class OrderOutcome { None, Message, Custom, Deployed, Moved, Captured, Repelled, Bombed, Blockaded, Airlifted, Negotiated };
+
+//Typed record of an order's effect. execute() only fills in these fields; the text of the effect is built from them by
+//getEffect(), which is only called when the effect is shown or logged.
+struct OrderRecord {
+	OrderOutcome outcome = OrderOutcome::None;
+	const char* message = ""; //Fixed text of an OrderOutcome::Message
+	Player* owner = nullptr;
+	Player* enemy = nullptr;
+	Territory* source = nullptr;
+	Territory* target = nullptr;
+	int armies = 0;
+	int armiesBefore = 0; //Armies on the target before the order
+
+	OrderRecord();
+	OrderRecord(Player* owner, const char* message);
+	OrderRecord(OrderOutcome outcome, Player* owner, Player* enemy, Territory* source, Territory* target, int armies);
+};
+
+//Name of an outcome, as written by the log decoder
+const char* outcomeName(OrderOutcome outcome);
+
+//Kind of an order, stored in the order itself so it can be told apart without comparing names or casting
+enum class OrderType : uint8_t { None, Deploy, Advance, Bomb, Blockade, Airlift, Negotiate };
+
+//Name of an order type, as shown and logged ("Deploy", "Advance", ...)
+const char* orderTypeName(OrderType type);
+
+//Classes of orders in the order they are executed: every deploy, then every airlift, then every blockade, then the rest
+enum class OrderPriority : uint8_t { Deploy, Airlift, Blockade, Other };
+const int numOrderPriorities = 4;
+
+OrderPriority priorityOf(OrderType type);
+
+//Compact copy of an order, 16 bytes with no pointers: players are positions in the game's list of players and territories
+//are positions on the map (-1 for none). The execution lanes hold orders in this form, and snapshots store them in it. Kept trivial so it can
+//be copied as raw bytes, which means its fields start out uninitialised: fill in every one of them.
+struct OrderData {
+	OrderType type;
+	int8_t owner;
+	int8_t otherPlayer; //Player a Negotiate is with
+	uint8_t flags; //executed, cannotBeAttacked
+	int32_t armies;
+	int32_t source;
+	int32_t target;
+
+	static const uint8_t executed = 1;
+	static const uint8_t cannotBeAttacked = 2;
+};
+
 //----------------------Orders class------------------
 class Orders : public ILoggable, public Subject{
 private:
 	bool executed = false;
-	string effect;
+	OrderRecord record;
+	string effect; //Text of an OrderOutcome::Custom effect
+	bool pooled = false; //Created by an OrderArena, which owns it
+	friend class OrderArena;
+protected:
+	OrderType type = OrderType::None; //Set by each kind of order's constructors
 public:
 
 	Orders();
-	//Copy constructor
+	//Copy constructor (a copy is never pooled)
 	Orders(const Orders& o);
-	~Orders(); //Destructor
+	virtual ~Orders(); //Destructor
 	Orders& operator = (const Orders& orders); //Assignment operator
 	friend ostream& operator << (ostream& strm, Orders& o); //Stream insertion operator
 	virtual bool validate();
 	virtual void execute();
-	virtual string getName();
+	//Name of the order's type
+	string getName();
+	OrderType getType() const;
+	//Player who issued the order, nullptr for an order of no particular kind
+	virtual Player* getOrderOwner();
+	//Compact copy of the order, with the players' positions taken from 'players'
+	OrderData toData(Map* map, const vector<Player*>& players);
+	//Creates the order described by 'data' in the game's arena, nullptr if its type is unknown
+	static Orders* fromData(const OrderData& data, GameEngine* game, Map* map, const vector<Player*>& players);
+	//Executes an order of the game's players (see toData) without an object of its class: a switch on its type runs the same
+	//rules as that class's execute(), and the outcome is logged the same way
+	static void execute(const OrderData& data, GameEngine* game);
 	void setExecuted(bool exec);
 	bool getExecuted() const;
+	//True if the order belongs to its game's OrderArena rather than to its list
+	bool isPooled() const;
 	void setEffect(string eff);
+	//Text of the effect, built from the order's record
 	string getEffect();
+	void setRecord(const OrderRecord& record);
+	const OrderRecord& getRecord() const;
 	
 	//****************** Should this be implemented in each individual order class instead??
 	// stringToLog Implementation for ILoggable
 	string stringToLog();
+	// toLogRecord Implementation for ILoggable
+	bool toLogRecord(LogRecord& logRecord);
 	
 };
 
@@ -47,6 +124,11 @@ class OrdersList : public ILoggable, public Subject {
 private:
 
     Player* ordersListOwner;
+	//Execution lanes filled by queueForExecution(), one per priority class, and the position of the next order to execute in each.
+	//They hold the orders as values, in one contiguous array each.
+	vector<OrderData> lanes[numOrderPriorities];
+	size_t nextIndex[numOrderPriorities] = {};
+	long long executedCount[numOrderPriorities] = {};
 public:
 	explicit OrdersList(Player* ordersListOwner,vector<Orders*>& ordersList); //Parameterised constructor
 	OrdersList(const OrdersList& ol);
@@ -58,10 +140,22 @@ public:
 	friend ostream& operator << (ostream& strm, OrdersList& ordersList);
 	void addOrders(Orders* o);
     void removeOrder(Orders* o);
+	//Drops every order in the list and in the lanes, deleting those that are not pooled (the arena reclaims the others)
+	void clear();
+	//Moves the pending orders into the execution lanes of their priority class, in issue order, as OrderData (see
+	//Orders::toData). The order objects are done with: those that are not pooled are deleted.
+	void queueForExecution();
+	//Next order of a lane, to run with Orders::execute(const OrderData&, GameEngine*), nullptr once the lane is exhausted.
+	//Executed orders are not erased, so this is O(1); they are only dropped by clear().
+	const OrderData* next(OrderPriority priority);
+	//Orders of a priority class taken from this list for execution since it was created
+	long long getExecutedCount(OrderPriority priority) const;
 	
 	//******************
 	// stringToLog Implementation for ILoggable
 	string stringToLog();
+	// toLogRecord Implementation for ILoggable
+	bool toLogRecord(LogRecord& logRecord);
 	
 };
 
@@ -70,7 +164,6 @@ class Deploy : public Orders {
 private:
 	GameEngine* game;
 	Player* orderOwner;
-	string name = "Deploy";
 	int noOfArmies;
 	Territory* target;
 public:
@@ -80,9 +173,9 @@ public:
 	~Deploy(); //Destructor
 	void setNoOfArmies(int noOfArmies);
 	int getNoOfArmies() const;
-	string getName();
 	void setTarget(Territory* target);
 	Territory* getTarget();
+	Player* getOrderOwner();
 	friend ostream& operator << (ostream& strm, Deploy& deploy);
 	bool validate();
 	void execute();
@@ -94,7 +187,6 @@ class Advance : public Orders {
 private:
 	GameEngine* game;
 	Player* orderOwner;
-	string name = "Advance";
 	int noOfArmies;
 	Territory* source;
 	Territory* target;
@@ -105,12 +197,12 @@ public:
 	Advance& operator = (const Advance& advance); //Assignment operator
 	~Advance(); //Destructor
 	void setNoOfArmies(int noOfArmies);
-	string getName();
 	int getNoOfArmies() const;
 	void setSource(Territory* source);
 	Territory* getSource();
 	void setTarget(Territory* target);
 	Territory* getTarget();
+	Player* getOrderOwner();
 	friend ostream& operator << (ostream& strm, Advance& advance);
     bool cannotBeAttacked = false;
 	bool validate();
@@ -123,7 +215,6 @@ class Bomb : public Orders {
 private:
 	GameEngine* game;
 	Player* orderOwner;
-	string name = "Bomb";
 	Territory* target;
 public:
 	explicit Bomb(Player* orderOwner, Territory* target, GameEngine* game);
@@ -132,8 +223,8 @@ public:
 	~Bomb();
 	Bomb& operator = (const Bomb& bomb);
 	void setTarget(Territory* target);
-	string getName();
 	Territory* getTarget();
+	Player* getOrderOwner();
 	friend ostream& operator << (ostream& strm, Bomb& bomb);
 	bool validate();
 	void execute();
@@ -145,7 +236,6 @@ class Blockade : public Orders {
 private:
 	GameEngine* game;
 	Player* orderOwner;
-	string name = "Blockade";
 	Territory* target;
 public:
 	Blockade(Player* orderOwner,Territory* target,GameEngine* gameEngine1);
@@ -153,9 +243,9 @@ public:
 	Blockade(const Blockade& blockade);
 	~Blockade();
 	Blockade& operator = (const Blockade& blockade);
-	string getName();
 	void setTarget(Territory* target);
 	Territory* getTarget();
+	Player* getOrderOwner();
 	friend ostream& operator << (ostream& strm, Blockade& blockade);
 	bool validate();
 	void execute();
@@ -167,7 +257,6 @@ class Airlift : public Orders {
 private:
 	GameEngine* game;
 	Player* orderOwner;
-	string name = "Airlift";
 	int noOfArmies;
 	Territory* source;
 	Territory* target;
@@ -183,7 +272,7 @@ public:
 	Territory* getSource();
 	void setTarget(Territory* target);
 	Territory* getTarget();
-	string getName();
+	Player* getOrderOwner();
 	friend ostream& operator << (ostream& strm, Airlift& airlift);
 	bool validate();
 	void execute();
@@ -196,14 +285,14 @@ private:
 	GameEngine* game;
 	Player* orderOwner;
     Player* otherPlayer;
-	string name = "Negotiate";
 public:
 	Negotiate(Player* orderOwner,Player* otherPlayer, GameEngine* game);
 	//Copy constructor
 	Negotiate(const Negotiate& negotiate);
 	~Negotiate();
 	Negotiate& operator= (const Negotiate& negotiate);
-	string getName();
+	Player* getOtherPlayer();
+	Player* getOrderOwner();
 	friend ostream& operator << (ostream& strm, Negotiate& negotiate);
 	bool validate();
 	void execute();
@@ -2,7 +2,6 @@
 
 int main(){
 
-    srand((int)time(nullptr));
 
     cout << "Part 4: Order Execution Implementation\n" << endl;
 
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include "Rollout.h"
+
+using namespace std;
+
+// Rollouts per second over 'numThreads' threads, each playing 'perThread' rollouts of 'depth' rounds from the same start
+static double rolloutRate(const Rollout& rollout, const RolloutState& start, const vector<RolloutMove>& moves, int depth, int numThreads, int perThread) {
+	auto begin = chrono::steady_clock::now();
+	vector<thread> pool;
+	for (int t = 0; t < numThreads; t++) {
+		pool.emplace_back([&, t]() {
+			RolloutState state;
+			double total = 0;
+			for (int i = 0; i < perThread; i++) {
+				Random rng((uint64_t)t * perThread + i);
+				state = start;
+				total += rollout.play(state, 0, moves[i % moves.size()], depth, rng);
+			}
+			if (total < 0) cout << total; // Keeps the work from being optimised away
+		});
+	}
+	for (thread& t : pool) {
+		t.join();
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+	return numThreads * perThread / seconds;
+}
+
+int main(int argc, char* argv[]) {
+	string mapFileName = argc > 1 ? argv[1] : "../Map/Assets/solar.map";
+	Map* map = MapLoader::createMapfromFile(mapFileName);
+	if (map == NULL) {
+		return 1;
+	}
+
+	// Two players and the neutral player, territories dealt out in turn with 5 armies each, 10 armies to deploy
+	int numTerritories = map->getTerritories().size();
+	RolloutState start;
+	for (int t = 0; t < numTerritories; t++) {
+		start.owner.push_back(t % 3);
+		start.armies.push_back(5);
+	}
+	start.pool = { 10, 10, 0 };
+	start.active = { 1, 1, 0 };
+
+	Rollout rollout(map->getTopology());
+	vector<RolloutMove> moves;
+	rollout.candidates(start, 0, vector<char>(3, 0), 24, moves);
+
+	cout << "Monte Carlo rollouts on " << mapFileName << " (" << numTerritories << " territories, " << moves.size() << " candidate moves)\n" << endl;
+
+	int cores = max(1, (int)thread::hardware_concurrency());
+	int depths[] = { 1, 2, 4 };
+	for (int depth : depths) {
+		double single = rolloutRate(rollout, start, moves, depth, 1, 200000);
+		double parallel = rolloutRate(rollout, start, moves, depth, cores, 200000);
+		cout << depth << " round(s) per rollout: " << (long long)single << " rollouts/s on one thread, " << (long long)parallel << " rollouts/s on "
+			<< cores << " threads" << endl;
+	}
+
+	delete map;
+	return 0;
+}
@@ -55,22 +55,29 @@ Player& Player::operator=(const Player& player)
 	return *this;
 }
 
-// Add territory to own
+// Add territory to own, taking it away from its previous owner
 void Player::addOwnedTerritory(Territory* territory) {
+	if (ownsTerritory(territory)) {return;}
+
+	Player* previousOwner = territory->getOwner();
+	if (previousOwner != nullptr) {previousOwner->removeOwnedTerritory(territory);}
+
+	territory->ownedPosition = territoriesOwned.size();
 	territoriesOwned.push_back(territory);
     territory->setOwner(this);
+	if (gameEngine != nullptr) {gameEngine->logOwnershipChange(territory, previousOwner, this);}
 }
 
 // Return a list of owned territories (to be defended)
-vector<Territory*> Player::toDefend()
+const vector<Territory*>& Player::toDefend(size_t count)
 {
-	return ps->toDefend();
+	return ps->toDefend(count);
 }
 
 // Return a list of territories to attack
-vector<Territory*> Player::toAttack()
+const vector<Territory*>& Player::toAttack(size_t count)
 {
-	return ps->toAttack();
+	return ps->toAttack(count);
 }
 
 // Create a new order and add to order list
@@ -79,14 +86,19 @@ void Player::issueOrder()
 	ps->issueOrder();
 }
 
+// The territory's own position in the list makes this a constant time check
 bool Player::ownsTerritory(Territory* territory) {
-	for (Territory* t : territoriesOwned) {
-		if (t == territory) {return true;}
-	}
-	return false;
+	int position = territory->ownedPosition;
+	return position >= 0 && position < (int)territoriesOwned.size() && territoriesOwned[position] == territory;
 }
 
 bool Player::ownsTerritory(int index) {
+	// Territories of a map can be looked up directly
+	if (gameEngine != nullptr && gameEngine->getMap() != nullptr) {
+		Territory* territory = gameEngine->getMap()->getTerritoryByIndex(index);
+		return territory != nullptr && ownsTerritory(territory);
+	}
+
     for (Territory* t : territoriesOwned) {
         if (t->getIndex() == index) {return true;}
     }
@@ -123,17 +135,46 @@ ostream& operator<<(ostream& out, const Player& player) {
 	return out << player.name;
 }
 
+// Swap the last territory into the removed one's place, so removal takes constant time
 void Player::removeOwnedTerritory(Territory * territory) {
-	territoriesOwned.erase(remove(territoriesOwned.begin(), territoriesOwned.end(), territory), territoriesOwned.end());
+	if (!ownsTerritory(territory)) {return;}
+
+	int position = territory->ownedPosition;
+	Territory* last = territoriesOwned.back();
+	territoriesOwned[position] = last;
+	last->ownedPosition = position;
+	territoriesOwned.pop_back();
+
+	territory->ownedPosition = -1;
+	if (territory->getOwner() == this) {territory->setOwner(nullptr);}
 }
 
-vector<Territory*> Player::getOwnedTerritories()
+const vector<Territory*>& Player::getOwnedTerritories()
 {
 	return territoriesOwned;
 }
 
+int Player::getNumberOfOwnedTerritories()
+{
+	return territoriesOwned.size();
+}
+
 void Player::setOwnedTerritories(vector<Territory *> & newVector) {
-    territoriesOwned = newVector;
+	// Copy first, in case 'newVector' is this player's own list
+	vector<Territory*> territories = newVector;
+	while (!territoriesOwned.empty()) {removeOwnedTerritory(territoriesOwned.back());}
+	for (Territory* t : territories) {addOwnedTerritory(t);}
+}
+
+void Player::restoreOwnedTerritories(Map* map, const int* positions, int count) {
+	for (Territory* t : territoriesOwned) {t->ownedPosition = -1;}
+	territoriesOwned.clear();
+
+	for (int i = 0; i < count; i++) {
+		Territory* t = map->getTerritoryAt(positions[i]);
+		t->ownedPosition = i;
+		territoriesOwned.push_back(t);
+	}
 }
 
 PlayerStrategy* Player::getPlayerStrategy()
@@ -2,6 +2,7 @@
 #include <iostream> // Used for cout and stream insertion operator
 #include <vector> // Used for lists instead of arrays
 #include <algorithm> // Used for binary search
+#include <cstdint> // Used for SIZE_MAX
 #include "../Cards/Cards.h"
 #include "../Orders/Orders.h"
 #include "../Map/Map.h"
@@ -26,12 +27,14 @@ public:
 	Player(const Player &player); // Copy constructor
 	~Player(); // Destructor
 	Player& operator =(const Player& player); // Assignment operator
-	void addOwnedTerritory(Territory*);
+	void addOwnedTerritory(Territory*); // Takes the territory away from its previous owner, if any
     void removeOwnedTerritory(Territory*);
-	vector<Territory*> toDefend();	// Returns a list of territories that are to be defended (owned territories)
-	vector<Territory*> toAttack();	// Returns a list of territories that are to be attacked
+	// Lists of territories to defend (owned territories) and to attack, in the strategy's order. They are cached until the map
+	// changes, so calling them again in a turn is free. With a 'count', only the first 'count' territories are sorted.
+	const vector<Territory*>& toDefend(size_t count = SIZE_MAX);
+	const vector<Territory*>& toAttack(size_t count = SIZE_MAX);
 	void issueOrder();
-	bool ownsTerritory(Territory* t); // Whether player owns a territory in defend list
+	bool ownsTerritory(Territory* t); // Whether player owns a territory in defend list (constant time)
 	bool ownsTerritory(int index);
 	string getName(); // Name getter
 	Hand* getHand(); // Hand pointer getter
@@ -42,8 +45,12 @@ public:
 	GameEngine* getGameEngine();
 	friend ostream& operator<<(ostream& out, const Player& player); // Stream insertion operator
     vector<Player*> cannotAttack; //Vector of players which cannot be attacked
-	vector<Territory*> getOwnedTerritories();
+	const vector<Territory*>& getOwnedTerritories(); // Read-only view, copy it before changing ownership while iterating
+	int getNumberOfOwnedTerritories();
 	void setOwnedTerritories(vector<Territory*>&);
+	// Replaces the list of owned territories with the territories at the given map positions, in that order, without changing who the territories
+	// belong to or logging anything (used to restore a snapshot, see GameSnapshot). Every player's list must be emptied (count 0) before any is refilled.
+	void restoreOwnedTerritories(Map* map, const int* positions, int count);
     bool receivedCardThisTurn = false;
 	PlayerStrategy* getPlayerStrategy();
 	void setPlayerStrategy(PlayerStrategy*);
@@ -51,7 +58,7 @@ private:
 	string name;
     GameEngine* gameEngine;
 	Hand* hand; // Pointer to hand of cards
-	vector<Territory*> territoriesOwned; // List of owned territories
+	vector<Territory*> territoriesOwned; // List of owned territories, in no particular order (each territory knows its position in it)
 	OrdersList* ordersList;
 	int reinforcementPool; // Number of armies in the reinforcement pool
 	PlayerStrategy* ps; // Pointer to a player strategy
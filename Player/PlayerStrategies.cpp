@@ -1,4 +1,10 @@
 #include "PlayerStrategies.h" // Include header file
+#include "Rollout.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <climits>
 
 // Gets the pointer pointing to the player
 Player* PlayerStrategy::getPlayer()
@@ -12,12 +18,71 @@ void PlayerStrategy::setPlayer(Player* player)
 	p = player;
 }
 
+bool TerritoryOrdering::isStale(Map* map)
+{
+	return map == nullptr || map->getState() != state || state->getEpoch() != epoch;
+}
+
+void TerritoryOrdering::rebuild(Map* map, vector<Territory*> list)
+{
+	territories = move(list);
+	state = map != nullptr ? map->getState() : nullptr;
+	epoch = state != nullptr ? state->getEpoch() : 0;
+	sorted = 0;
+}
+
+// partial_sort leaves the rest of the list after everything it sorted, so sorting more later carries on from there
+void TerritoryOrdering::sortFirst(TerritoryOrder order, size_t count)
+{
+	count = min(count, territories.size());
+	if (order == nullptr || count <= sorted) {
+		return;
+	}
+
+	if (count == territories.size()) {
+		sort(territories.begin() + sorted, territories.end(), order);
+	}
+	else {
+		partial_sort(territories.begin() + sorted, territories.begin() + count, territories.end(), order);
+	}
+	sorted = count;
+}
+
+Map* PlayerStrategy::gameMap()
+{
+	return p != nullptr && p->getGameEngine() != nullptr ? p->getGameEngine()->getMap() : nullptr;
+}
+
+// Territories next to the player's own that it does not own, each listed once
+static vector<Territory*> enemyNeighbours(Player* player)
+{
+	vector<Territory*> neighbours;
+	for (Territory* t : player->getOwnedTerritories()) {
+		for (Territory* a : t->getAdjacentTerritories()) {
+			if (!player->ownsTerritory(a) && find(neighbours.begin(), neighbours.end(), a) == neighbours.end()) {
+				neighbours.push_back(a);
+			}
+		}
+	}
+	return neighbours;
+}
+
+const vector<Territory*>& PlayerStrategy::attackable(TerritoryOrder order, size_t count)
+{
+	// The map keeps every player's frontier up to date; a player that is not in a game on a map walks its territories instead
+	Map* map = gameMap();
+	return attacking.get(map, [this, map]() { return map != nullptr ? map->getFrontier(p) : enemyNeighbours(p); }, order, count);
+}
+
 // Default parametrized constructor
 PlayerStrategy::PlayerStrategy(Player* player, strategyName strategyName) : p(player), strN(strategyName) { }
 
 // Copy constructor
 PlayerStrategy::PlayerStrategy(const PlayerStrategy& ps) : p(ps.p), strN(ps.strN) { }
 
+// Destructor
+PlayerStrategy::~PlayerStrategy() { }
+
 // Overloading the assignment operator
 PlayerStrategy& PlayerStrategy::operator=(const PlayerStrategy& ps)
 {
@@ -68,7 +133,7 @@ void HumanPlayerStrategy::issueOrder()
 
 	// Prints out the list of territories to defend
 	cout << "\nTerritories to defend: (Index : Name)" << endl;
-	for (auto it : toDefend()) {
+	for (auto it : p->toDefend()) {
 		cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 	}
 	cout << endl;
@@ -106,7 +171,7 @@ void HumanPlayerStrategy::issueOrder()
 				else {
 
 					// Add a deploy order to the player's list of orders
-					orders->addOrders(new Deploy(p, deployNo, game->getMap()->getTerritoryByIndex(tIndex), game));
+					orders->addOrders(game->getOrderArena().create<Deploy>(p, deployNo, game->getMap()->getTerritoryByIndex(tIndex), game));
 					
 					// Sets the reinforcement pool with whatever is left after the user's input
 					p->setReinforcementPool(p->getReinforcementPool() - deployNo);
@@ -160,7 +225,7 @@ void HumanPlayerStrategy::issueOrder()
 
 			// List of territories to defend
 			cout << "\nTerritories to defend: (Index : Name)" << endl;
-			for (auto it : toDefend()) {
+			for (auto it : p->toDefend()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
@@ -197,7 +262,7 @@ void HumanPlayerStrategy::issueOrder()
 							<< target->getName() << " " << army << " armies!" << endl;
 
 						// Adds the advance order to the player's list of order
-						orders->addOrders(new Advance(p, army, source, target, game));
+						orders->addOrders(game->getOrderArena().create<Advance>(p, army, source, target, game));
 					}
 
 					// Input number of armies to move is bigger than number of armies in source territory
@@ -222,14 +287,14 @@ void HumanPlayerStrategy::issueOrder()
 		else if (ans == 2) {
 			// List of territories to defend
 			cout << "\nTerritories to defend: (Index : Name)" << endl;
-			for (auto it : toDefend()) {
+			for (auto it : p->toDefend()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
 
 			// List of territories to attack
 			cout << "\nTerritories to attack: (Index : Name)" << endl;
-			for (auto it : toAttack()) {
+			for (auto it : p->toAttack()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
@@ -254,7 +319,7 @@ void HumanPlayerStrategy::issueOrder()
 
 				// Check if target is adjacent to any of the player's owned territories
 				bool targetCanBeAttacked = false;
-				for (auto it : toAttack()) {
+				for (auto it : p->toAttack()) {
 					if (it == target) {
 						targetCanBeAttacked = true;
 					}
@@ -274,7 +339,7 @@ void HumanPlayerStrategy::issueOrder()
 							<< target->getName() << " " << army << " armies!" << endl;
 
 						//Takes care of what happens if diplomacy was used last turn
-						Advance* advance = new Advance(p, army, source, target, game);
+						Advance* advance = game->getOrderArena().create<Advance>(p, army, source, target, game);
 						for (auto it : p->cannotAttack) {
 							if (it == target->getOwner()) {
 								advance->cannotBeAttacked = true;
@@ -363,7 +428,7 @@ void HumanPlayerStrategy::issueOrder()
 
 			// List of territories to attack
 			cout << "\nTerritories to attack: (Index : Name)" << endl;
-			for (auto it : toAttack()) {
+			for (auto it : p->toAttack()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
@@ -391,7 +456,7 @@ void HumanPlayerStrategy::issueOrder()
 
 			// List of territories to defend
 			cout << "\nTerritories to defend: (Index : Name)" << endl;
-			for (auto it : toDefend()) {
+			for (auto it : p->toDefend()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
@@ -415,7 +480,7 @@ void HumanPlayerStrategy::issueOrder()
 
 			// List of territories to defend
 			cout << "\nTerritories to defend: (Index : Name)" << endl;
-			for (auto it : toDefend()) {
+			for (auto it : p->toDefend()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
@@ -432,7 +497,7 @@ void HumanPlayerStrategy::issueOrder()
 
 			// List of territories to defend
 			cout << "\nTerritories to defend: (Index : Name)" << endl;
-			for (auto it : toDefend()) {
+			for (auto it : p->toDefend()) {
 				cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 			}
 			cout << endl;
@@ -486,32 +551,14 @@ void HumanPlayerStrategy::issueOrder()
 }
 
 // toAttack() method for the HumanPlayerStrategy. It returns a vector of all territories that can be attacked
-vector<Territory*> HumanPlayerStrategy::toAttack()
+const vector<Territory*>& HumanPlayerStrategy::toAttack(size_t count)
 {
-
-	// Vector containing all the territories that can be attacked
-	vector<Territory*> attackableTerritories;
-
-	// Double for-loop that adds the attackable territory to the vector
-	for (Territory* t : p->getOwnedTerritories()) {
-		for (Territory* a : t->getAdjacentTerritories()) {
-			// Excluding owned territories
-			if (!p->ownsTerritory(a)) {
-				// Add territory to attack list
-				attackableTerritories.push_back(a);
-			}
-		}
-	}
-
-	// Remove duplicates
-	for (Territory* t : attackableTerritories) {
-		attackableTerritories.erase(unique(attackableTerritories.begin(), attackableTerritories.end()), attackableTerritories.end());
-	}
-	return attackableTerritories;
+	// The map keeps every player's frontier up to date as territories change hands
+	return attackable(nullptr, count);
 }
 
 // toDefend() method for the HumanPlayerStrategy. It returns a vector of all the territories owned by the player
-vector<Territory*> HumanPlayerStrategy::toDefend() {
+const vector<Territory*>& HumanPlayerStrategy::toDefend(size_t) {
 	return p->getOwnedTerritories();
 }
 
@@ -543,56 +590,56 @@ void AggressivePlayerStrategy::issueOrder() {
 	OrdersList* orders = p->getOrdersList();
 
 	// Introduction message for each player
-	cout << "\nIssuing orders for player " << p->getName() << ":" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\nIssuing orders for player " << p->getName() << ":" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
-	cout << "#--- Deploying Phase ---#" << endl;
+	NARRATE(game) << "#--- Deploying Phase ---#" << endl;
 
 	// List of territories to defend
-	cout << "\nTerritories to defend: (Index : Name)" << endl;
-	for (auto it : toDefend()) {
-		cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
+	NARRATE(game) << "\nTerritories to defend: (Index : Name)" << endl;
+	for (auto it : p->toDefend()) {
+		NARRATE(game) << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 	}
-	cout << endl;
+	NARRATE(game) << endl;
 
 	// Deploy all to strongest territory
 	while (p->getReinforcementPool() > 0) {
 		// Announce how big the reinforcement pool is
-		cout << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
-		cout << "Player " << p->getName() << " has chosen territory " << p->toDefend().at(0)->getName() << " to defend with " << p->getReinforcementPool() << " armies." << endl;;
+		NARRATE(game) << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
+		NARRATE(game) << "Player " << p->getName() << " has chosen territory " << p->toDefend(1).at(0)->getName() << " to defend with " << p->getReinforcementPool() << " armies." << endl;;
 		
 		// Adds a deploy order to the strongest owned country to the player's list of orders
-		orders->addOrders(new Deploy(p, p->getReinforcementPool(), p->toDefend().at(0), game));
+		orders->addOrders(game->getOrderArena().create<Deploy>(p, p->getReinforcementPool(), p->toDefend(1).at(0), game));
 
 		// Since the whole reinforcement pool was used for the deploy order, we set it to 0
 		p->setReinforcementPool(0);
 	}
 
-	cout << "\n#--- Deploying Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Deploying Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All deploy orders have been issued at this point
 
 	// Now issuing advance orders
-	cout << "\n#--- Advancing Phase ---#" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase ---#" << endl;
 
 	// List of territories to attack
-	cout << "\nTerritories to attack: (Index : Name)" << endl;
-	for (auto it : toAttack()) {
-		cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
+	NARRATE(game) << "\nTerritories to attack: (Index : Name)" << endl;
+	for (auto it : p->toAttack()) {
+		NARRATE(game) << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 	}
-	cout << endl;
+	NARRATE(game) << endl;
 
 	// Check if there are any countries to attack
-	if (toAttack().size() > 0) {
-		Territory* source = toDefend().at(0); // The source is the strongest owned territory
-		Territory* target = toAttack().at(0); // The target is the first attackable territory
+	if (!p->toAttack(0).empty()) {
+		Territory* source = p->toDefend(1).at(0); // The source is the strongest owned territory
+		Territory* target = p->toAttack(1).at(0); // The target is the first attackable territory
 		int army = source->getNumberOfArmies(); // Every attack will use all the armies from the source
 
-		cout << "Advancing from " << source->getName() << " to "
+		NARRATE(game) << "Advancing from " << source->getName() << " to "
 			<< target->getName() << " " << army << " armies!" << endl;
 		//Takes care of what happens if diplomacy was used last turn
-		Advance* advance = new Advance(p, army, source, target, game);
+		Advance* advance = game->getOrderArena().create<Advance>(p, army, source, target, game);
 		for (auto it : p->cannotAttack) {
 			if (it == target->getOwner()) {
 				advance->cannotBeAttacked = true;
@@ -601,22 +648,22 @@ void AggressivePlayerStrategy::issueOrder() {
 		orders->addOrders(advance);
 	}
 
-	cout << "Sending all armies from weaker countries to strongest country!" << endl;
+	NARRATE(game) << "Sending all armies from weaker countries to strongest country!" << endl;
 	// Advance all armies from weaker countries to strongest country
-	for (int i = 1; i < toDefend().size(); i++) {
-		Territory* source = toDefend().at(i);
-		Territory* target = toDefend().at(0);
+	for (int i = 1; i < p->toDefend().size(); i++) {
+		Territory* source = p->toDefend().at(i);
+		Territory* target = p->toDefend().at(0);
 		int army = source->getNumberOfArmies();
 
-		cout << "Advancing from " << source->getName() << " to "
+		NARRATE(game) << "Advancing from " << source->getName() << " to "
 			<< target->getName() << " " << army << " armies!" << endl;
 		//Takes care of what happens if diplomacy was used last turn
-		Advance* advance = new Advance(p, army, source, target, game);
+		Advance* advance = game->getOrderArena().create<Advance>(p, army, source, target, game);
 		orders->addOrders(advance);
 	}
 
-	cout << "\n#--- Advancing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All advance orders have been issued at this point!
 
@@ -624,7 +671,7 @@ void AggressivePlayerStrategy::issueOrder() {
 	p->cannotAttack.clear();
 
 	// Now playing a card, Player plays one card per turn. The aggressive player cannot play blockade nor diplomacy cards
-	cout << "\n#--- Card Playing Phase ---#" << endl << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase ---#" << endl << endl;
 
 	if (hand->getSize() > 0)
 	{
@@ -635,69 +682,52 @@ void AggressivePlayerStrategy::issueOrder() {
 			string cardName = currentCard->getCardTypeName();
 			// Cases for each type of card that could be played
 			if (cardName == "Bomb") {
-				cout << "Bomb card selected:" << endl;
-				Territory* enemyT = toAttack().at(0);
+				NARRATE(game) << "Bomb card selected:" << endl;
+				Territory* enemyT = p->toAttack(1).at(0);
 				currentCard->play(i, 0, p, nullptr, nullptr, enemyT, game);
-				cout << "Bomb order will be issued on !" << enemyT->getName() << endl;
+				NARRATE(game) << "Bomb order will be issued on !" << enemyT->getName() << endl;
 				break;
 			}
 			else if (cardName == "Reinforcement") {
-				cout << "Reinforcement card selected: " << endl;
+				NARRATE(game) << "Reinforcement card selected: " << endl;
 				currentCard->play(i, 0, p, nullptr, nullptr, nullptr, game);
 				break;
 			}
 			else if (cardName == "Airlift") {
-				if (toDefend().size() > 1) {
-					cout << "Airlift card selected:" << endl;
-					Territory* ownT = toDefend().at(1);
-					Territory* otherOwnT = toDefend().at(0);
+				if (p->getOwnedTerritories().size() > 1) {
+					NARRATE(game) << "Airlift card selected:" << endl;
+					Territory* ownT = p->toDefend(2).at(1);
+					Territory* otherOwnT = p->toDefend(1).at(0);
 					currentCard->play(i, ownT->getNumberOfArmies(), p, nullptr, ownT, otherOwnT, game);
-					cout << "Airlift order will be issued!";
+					NARRATE(game) << "Airlift order will be issued!";
 					break;
 				}
 			}
 
 			// In case the player has no cards in their hand that they can play
 			if (i == handSize - 1) {
-				cout << "Player " << p->getName() << " has no cards in their hand they should play, skipping the card playing phase!" << endl;
+				NARRATE(game) << "Player " << p->getName() << " has no cards in their hand they should play, skipping the card playing phase!" << endl;
 			}
 		}
 	}
 
 	// If the player has no cards in their hand at all
 	else {
-		cout << "Player " << p->getName() << " has no cards in their hand, skipping the card playing phase!" << endl;
+		NARRATE(game) << "Player " << p->getName() << " has no cards in their hand, skipping the card playing phase!" << endl;
 	}
 
-	cout << "\n#--- Card Playing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 }
 
 // toAttack() method for the AggressivePlayerStrategy. It returns a vector of all territories that can be attacked
-vector<Territory*> AggressivePlayerStrategy::toAttack() {
-	vector<Territory*> attackableTerritories;
-	for (Territory* t : p->getOwnedTerritories()) {
-		for (Territory* a : t->getAdjacentTerritories()) {
-			// Excluding owned territories
-			if (!p->ownsTerritory(a)) {
-				// Add territory to attack list
-				attackableTerritories.push_back(a);
-			}
-		}
-	}
-	// Remove duplicates
-	for (Territory* t : attackableTerritories) {
-		attackableTerritories.erase(unique(attackableTerritories.begin(), attackableTerritories.end()), attackableTerritories.end());
-	}
-	sort(attackableTerritories.begin(), attackableTerritories.end(), weakestTerritory);
-	return attackableTerritories;
+const vector<Territory*>& AggressivePlayerStrategy::toAttack(size_t count) {
+	return attackable(weakestTerritory, count);
 }
 
 // toDefend() method for the AggressivePlayerStrategy. It returns a vector of all the territories owned by the player
-vector<Territory*> AggressivePlayerStrategy::toDefend() {
-	vector<Territory*> OwnedTerritories = p->getOwnedTerritories();
-	sort(OwnedTerritories.begin(), OwnedTerritories.end(), strongestTerritory);
-	return OwnedTerritories;
+const vector<Territory*>& AggressivePlayerStrategy::toDefend(size_t count) {
+	return defending.get(gameMap(), [this]() { return p->getOwnedTerritories(); }, strongestTerritory, count);
 }
 
 // Overloading the output operator
@@ -728,37 +758,37 @@ void BenevolentPlayerStrategy::issueOrder() {
 	OrdersList* orders = p->getOrdersList();
 
 	// Introduction message for each player
-	cout << "\nIssuing orders for player " << p->getName() << ":" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\nIssuing orders for player " << p->getName() << ":" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
-	cout << "#--- Deploying Phase ---#" << endl;
+	NARRATE(game) << "#--- Deploying Phase ---#" << endl;
 
 	// List of territories to defend
-	cout << "\nTerritories to defend: (Index : Name)" << endl;
-	for (auto it : toDefend()) {
-		cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
+	NARRATE(game) << "\nTerritories to defend: (Index : Name)" << endl;
+	for (auto it : p->toDefend()) {
+		NARRATE(game) << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 	}
-	cout << endl;
+	NARRATE(game) << endl;
 
 	// Deploy all the reinforcement pool to its weakest country
 	while (p->getReinforcementPool() > 0) {
 		// Announce how big the reinforcement pool is
-		cout << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
-		cout << "Player " << p->getName() << " has chosen territory " << p->toDefend().at(0)->getName() << " to defend with " << p->getReinforcementPool() << " armies." << endl;
-		orders->addOrders(new Deploy(p, p->getReinforcementPool(), p->toDefend().at(0), game));
+		NARRATE(game) << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
+		NARRATE(game) << "Player " << p->getName() << " has chosen territory " << p->toDefend(1).at(0)->getName() << " to defend with " << p->getReinforcementPool() << " armies." << endl;
+		orders->addOrders(game->getOrderArena().create<Deploy>(p, p->getReinforcementPool(), p->toDefend(1).at(0), game));
 		p->setReinforcementPool(0);
 	}
 
-	cout << "\n#--- Deploying Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Deploying Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// Now issuing advance orders
-	cout << "\n#--- Advancing Phase ---#" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase ---#" << endl;
 
-	cout << "\nThe Benevolent Player has no advances to make." << endl;
+	NARRATE(game) << "\nThe Benevolent Player has no advances to make." << endl;
 
-	cout << "\n#--- Advancing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All advance orders have been issued at this point!
 
@@ -766,7 +796,7 @@ void BenevolentPlayerStrategy::issueOrder() {
 	p->cannotAttack.clear();
 
 	// Now playing a card, Player plays one card per turn
-	cout << "\n#--- Card Playing Phase ---#" << endl << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase ---#" << endl << endl;
 
 	// The benevolent player cannot use the bomb card
 	if (hand->getSize() > 0)
@@ -779,24 +809,24 @@ void BenevolentPlayerStrategy::issueOrder() {
 			// Cases for each type of card that could be played
 
 			if (cardName == "Blockade") {
-				cout << "Blockade card selected:" << endl;
-				Territory* target = toDefend().at(0);
+				NARRATE(game) << "Blockade card selected:" << endl;
+				Territory* target = p->toDefend(1).at(0);
 				currentCard->play(i, 0, p, nullptr, nullptr, target, game);
-				cout << "Blockade order will be issued on !" << target->getName() << endl;
+				NARRATE(game) << "Blockade order will be issued on !" << target->getName() << endl;
 				break;
 			}
 			else if (cardName == "Reinforcement") {
-				cout << "Reinforcement card selected: " << endl;
+				NARRATE(game) << "Reinforcement card selected: " << endl;
 				currentCard->play(i, 0, p, nullptr, nullptr, nullptr, game);
 				break;
 			}
 			else if (cardName == "Airlift") {
-				if (toDefend().size() > 1) {
-					cout << "Airlift card selected:" << endl;
-					Territory* ownT = toDefend().at(1);
-					Territory* otherOwnT = toDefend().at(0);
+				if (p->getOwnedTerritories().size() > 1) {
+					NARRATE(game) << "Airlift card selected:" << endl;
+					Territory* ownT = p->toDefend(2).at(1);
+					Territory* otherOwnT = p->toDefend(1).at(0);
 					currentCard->play(i, ownT->getNumberOfArmies(), p, nullptr, ownT, otherOwnT, game);
-					cout << "Airlift order will be issued!";
+					NARRATE(game) << "Airlift order will be issued!";
 					break;
 				}
 			}
@@ -811,38 +841,37 @@ void BenevolentPlayerStrategy::issueOrder() {
 				{
 					otherP = game->players.at(0);
 				}
-				cout << "Diplomacy card selected. " << endl;
-				cout << "Diplomacy order will be issued!" << endl;
+				NARRATE(game) << "Diplomacy card selected. " << endl;
+				NARRATE(game) << "Diplomacy order will be issued!" << endl;
 				currentCard->play(i, 0, p, otherP, nullptr, nullptr, game);
+				break;
 			}
 
 			// If the player has cards that cannot be played
 			if (i == handSize - 1) {
-				cout << "Player " << p->getName() << " has no cards in their hand they should play, skipping the card playing phase!" << endl;
+				NARRATE(game) << "Player " << p->getName() << " has no cards in their hand they should play, skipping the card playing phase!" << endl;
 			}
 		}
 	}
 
 	// If the player has no cards whatsoever to play
 	else {
-		cout << "Player " << p->getName() << " has no cards in their hand, skipping the card playing phase!" << endl;
+		NARRATE(game) << "Player " << p->getName() << " has no cards in their hand, skipping the card playing phase!" << endl;
 	}
 
-	cout << "\n#--- Card Playing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 }
 
 // Since the benevolent player never attacks, we return an empty vector
-vector<Territory*> BenevolentPlayerStrategy::toAttack() {
-	vector<Territory*> empty;
+const vector<Territory*>& BenevolentPlayerStrategy::toAttack(size_t) {
+	static const vector<Territory*> empty;
 	return empty;
 }
 
 // toDefend() method that returns a vector of territories pointers sorted from the weakest territory first
-vector<Territory*> BenevolentPlayerStrategy::toDefend() {
-	vector<Territory*> sortedOwnedTerritories = p->getOwnedTerritories();
-	sort(sortedOwnedTerritories.begin(), sortedOwnedTerritories.end(), weakestTerritory); // Sorting the vector
-	return sortedOwnedTerritories;
+const vector<Territory*>& BenevolentPlayerStrategy::toDefend(size_t count) {
+	return defending.get(gameMap(), [this]() { return p->getOwnedTerritories(); }, weakestTerritory, count);
 }
 
 // Overloading the output operator
@@ -876,39 +905,39 @@ void NeutralPlayerStrategy::issueOrder() {
 	OrdersList* orders = p->getOrdersList();
 
 	// Introduction message for each player
-	cout << "\nIssuing orders for player " << p->getName() << ":" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\nIssuing orders for player " << p->getName() << ":" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
-	cout << "#--- Deploying Phase ---#" << endl;
+	NARRATE(game) << "#--- Deploying Phase ---#" << endl;
 
 	// List of territories to defend
-	cout << "\nTerritories to defend: (Index : Name)" << endl;
-	for (auto it : toDefend()) {
-		cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
+	NARRATE(game) << "\nTerritories to defend: (Index : Name)" << endl;
+	for (auto it : p->toDefend()) {
+		NARRATE(game) << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 	}
-	cout << endl;
+	NARRATE(game) << endl;
 
 	// Deploy all to weakest territory
 	while (p->getReinforcementPool() > 0) {
 		// Announce how big the reinforcement pool is
-		cout << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
-		cout << "Player " << p->getName() << " has chosen territory " << p->toDefend().at(0)->getName() << " to defend with " << p->getReinforcementPool() << " armies." << endl;;
-		orders->addOrders(new Deploy(p, p->getReinforcementPool(), p->toDefend().at(0), game));
+		NARRATE(game) << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
+		NARRATE(game) << "Player " << p->getName() << " has chosen territory " << p->toDefend(1).at(0)->getName() << " to defend with " << p->getReinforcementPool() << " armies." << endl;;
+		orders->addOrders(game->getOrderArena().create<Deploy>(p, p->getReinforcementPool(), p->toDefend(1).at(0), game));
 		p->setReinforcementPool(0);
 	}
 
-	cout << "\n#--- Deploying Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Deploying Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All deploy orders have been issued at this point!
 
 	// Now issuing advance orders
-	cout << "\n#--- Advancing Phase ---#" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase ---#" << endl;
 
-	cout << "\nPlayer " << p->getName() << " has chosen not to advance." << endl;
+	NARRATE(game) << "\nPlayer " << p->getName() << " has chosen not to advance." << endl;
 
-	cout << "\n#--- Advancing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All advance orders have been issued at this point!
 
@@ -916,7 +945,7 @@ void NeutralPlayerStrategy::issueOrder() {
 	p->cannotAttack.clear();
 
 	// Now playing a card, Player plays one card per turn
-	cout << "\n#--- Card Playing Phase ---#" << endl << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase ---#" << endl << endl;
 	
 	// The neutral player cannot use the bomb card
 	if (hand->getSize() > 0)
@@ -928,8 +957,8 @@ void NeutralPlayerStrategy::issueOrder() {
 			string cardName = currentCard->getCardTypeName();
 			if (cardName == "Reinforcement")
 			{
-				cout << "Reinforcement card selected --> Will be played immediately below: " << endl;
-				cout << "Reinforcement order will be issued!" << endl;
+				NARRATE(game) << "Reinforcement card selected --> Will be played immediately below: " << endl;
+				NARRATE(game) << "Reinforcement order will be issued!" << endl;
 				currentCard->play(i, 0, p, nullptr, nullptr, nullptr, game);
 				break;
 			}
@@ -944,56 +973,55 @@ void NeutralPlayerStrategy::issueOrder() {
 				{
 					otherP = game->players.at(0);
 				}
-				cout << "Diplomacy card selected. " << endl;
-				cout << "Diplomacy order will be issued!" << endl;
+				NARRATE(game) << "Diplomacy card selected. " << endl;
+				NARRATE(game) << "Diplomacy order will be issued!" << endl;
 				currentCard->play(i, 0, p, otherP, nullptr, nullptr, game);
+				break;
 			}
 			else if (cardName == "Airlift") {
-				if (toDefend().size() > 1) {
-					cout << "Airlift card selected:" << endl;
-					Territory* ownT = toDefend().at(1);
-					Territory* otherOwnT = toDefend().at(0);
+				if (p->getOwnedTerritories().size() > 1) {
+					NARRATE(game) << "Airlift card selected:" << endl;
+					Territory* ownT = p->toDefend(2).at(1);
+					Territory* otherOwnT = p->toDefend(1).at(0);
 					currentCard->play(i, ownT->getNumberOfArmies(), p, nullptr, ownT, otherOwnT, game);
-					cout << "Airlift order will be issued!";
+					NARRATE(game) << "Airlift order will be issued!";
 					break;
 				}
 			}
 			else if (cardName == "Blockade") {
-				cout << "Blockade card selected:" << endl;
-				Territory* target = toDefend().at(0);
+				NARRATE(game) << "Blockade card selected:" << endl;
+				Territory* target = p->toDefend(1).at(0);
 				currentCard->play(i, 0, p, nullptr, nullptr, target, game);
-				cout << "Blockade order will be issued on !" << target->getName() << endl;
+				NARRATE(game) << "Blockade order will be issued on !" << target->getName() << endl;
 				break;
 			}
 
 			// If the player has no cards that can be played in their hand
 			if (i == handSize - 1) {
-				cout << "Player " << p->getName() << " has no cards in their hand they should play, skipping the card playing phase!" << endl;
+				NARRATE(game) << "Player " << p->getName() << " has no cards in their hand they should play, skipping the card playing phase!" << endl;
 			}
 		}
 	}
 
 	// If the player has no cards whatsoever to play
 	else {
-		cout << "Player " << p->getName() << " has no cards in their hand, skipping the card playing phase!" << endl;
+		NARRATE(game) << "Player " << p->getName() << " has no cards in their hand, skipping the card playing phase!" << endl;
 	}
 
-	cout << "\n#--- Card Playing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 }
 
 // A neutral player never attacks, so we return an empty vector of territories
-vector<Territory*> NeutralPlayerStrategy::toAttack() {
-	vector<Territory*> empty;
+const vector<Territory*>& NeutralPlayerStrategy::toAttack(size_t) {
+	static const vector<Territory*> empty;
 	return empty;
 }
 
 // toDefend() methods that returns a vector of territories pointers sorted by the weakest territories first
-vector<Territory*> NeutralPlayerStrategy::toDefend() {
-	vector<Territory*> OwnedTerritories = p->getOwnedTerritories();
-	sort(OwnedTerritories.begin(), OwnedTerritories.end(), weakestTerritory); // Sorting the vector
-	return OwnedTerritories;
+const vector<Territory*>& NeutralPlayerStrategy::toDefend(size_t count) {
+	return defending.get(gameMap(), [this]() { return p->getOwnedTerritories(); }, weakestTerritory, count);
 }
 
 // Overloading the output operator
@@ -1024,63 +1052,63 @@ void CheaterPlayerStrategy::issueOrder() {
 	OrdersList* orders = p->getOrdersList();
 
 	// Introduction message for each player
-	cout << "\nIssuing orders for player " << p->getName() << ":" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\nIssuing orders for player " << p->getName() << ":" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
-	cout << "#--- Deploying Phase ---#" << endl;
+	NARRATE(game) << "#--- Deploying Phase ---#" << endl;
 
 	// List of territories to defend
-	cout << "\nTerritories to defend: (Index : Name)" << endl;
-	for (auto it : toDefend()) {
-		cout << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
+	NARRATE(game) << "\nTerritories to defend: (Index : Name)" << endl;
+	for (auto it : p->toDefend()) {
+		NARRATE(game) << it->getIndex() << " : " + it->getName() << " , Armies: " << it->getNumberOfArmies() << endl;
 	}
-	cout << endl;
+	NARRATE(game) << endl;
 
 	// While the player still has armies to deploy (reinforcement pool is not empty)
 	while (p->getReinforcementPool() > 0) {
 		// Announce how big the reinforcement pool is
-		cout << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
+		NARRATE(game) << "Player " << p->getName() << "'s number of armies left in the reinforcement pool: " << p->getReinforcementPool() << endl << endl;
 
 
-		Territory* chosenTerritory = p->toDefend().at(0);
+		Territory* chosenTerritory = p->toDefend(1).at(0);
 		// Choose index of territory to defend
-		cout << "Player " << p->getName() << " has chosen to defend territory " << p->toDefend().at(0)->getName() << " with " << p->getReinforcementPool() << " armies." << endl;
+		NARRATE(game) << "Player " << p->getName() << " has chosen to defend territory " << p->toDefend(1).at(0)->getName() << " with " << p->getReinforcementPool() << " armies." << endl;
 
 		int deployNo = p->getReinforcementPool();
-		orders->addOrders(new Deploy(p, deployNo, chosenTerritory, game));
+		orders->addOrders(game->getOrderArena().create<Deploy>(p, deployNo, chosenTerritory, game));
 		p->setReinforcementPool(0);
 
 	}
 
-	cout << "\n#--- Deploying Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Deploying Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All deploy orders have been issued at this point!
 
 	// Now issuing advance orders
-	cout << "\n#--- Advancing Phase ---#" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase ---#" << endl;
 
 	vector<int> territoryPositions;
 
 	// For each attackable territory, adding its index in the territoryPositions vector
-	for (auto t : toAttack())
+	for (auto t : p->toAttack())
 	{
 		territoryPositions.push_back(t->getIndex());
 	}
 
-	cout << "\nCheater issuing advance orders on adjacent territories." << endl;
+	NARRATE(game) << "\nCheater issuing advance orders on adjacent territories." << endl;
 
 	// Cheater conquers all ajacent territories by using the territoryPositions vector
-	for (auto d : toDefend())
+	for (auto d : p->toDefend())
 	{
-		for (auto t : toAttack())
+		for (auto t : p->toAttack())
 		{
 			if (find(territoryPositions.begin(), territoryPositions.end(), t->getIndex()) != territoryPositions.end())
 			{
 				if (d->isAdjacent(t))
 				{
 					// Adding the advance order to the player's list of orders
-					orders->addOrders(new Advance(p, 1, d, t, game));
+					orders->addOrders(game->getOrderArena().create<Advance>(p, 1, d, t, game));
 					// Removing the territory conquered from the territoryPositions vector
 					territoryPositions.erase(remove(territoryPositions.begin(), territoryPositions.end(), t->getIndex()), territoryPositions.end());
 				}
@@ -1088,8 +1116,8 @@ void CheaterPlayerStrategy::issueOrder() {
 		}
 	}
 
-	cout << "\n#--- Advancing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Advancing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 	// All advance orders have been issued at this point!
 
@@ -1097,49 +1125,282 @@ void CheaterPlayerStrategy::issueOrder() {
 	p->cannotAttack.clear();
 
 	// Now playing a card, Player plays one card per turn
-	cout << "\n#--- Card Playing Phase ---#" << endl << endl;
-	cout << "\nThe cheater doesn't want to follow the rules, they don't play any cards." << endl;
-	cout << "\n#--- Card Playing Phase OVER ---#" << endl;
-	cout << "/*-------------------------------------------------------------------*/" << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase ---#" << endl << endl;
+	NARRATE(game) << "\nThe cheater doesn't want to follow the rules, they don't play any cards." << endl;
+	NARRATE(game) << "\n#--- Card Playing Phase OVER ---#" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
 
 }
 
 // toAttack() method that returns all attackable territories in a vector of territories pointers, sorted by weakest territories
-vector<Territory*> CheaterPlayerStrategy::toAttack() {
-	vector<Territory*> attackableTerritories;
-	for (Territory* t : p->getOwnedTerritories()) {
-		for (Territory* a : t->getAdjacentTerritories()) {
-			// Excluding owned territories
-			if (!p->ownsTerritory(a)) {
-				// Add territory to attack list
-				attackableTerritories.push_back(a);
+const vector<Territory*>& CheaterPlayerStrategy::toAttack(size_t count) {
+	return attackable(weakestTerritory, count);
+}
+
+// toDefend() that returns a sorted vector of territories pointers. The weakest territories are first
+const vector<Territory*>& CheaterPlayerStrategy::toDefend(size_t count) {
+	return defending.get(gameMap(), [this]() { return p->getOwnedTerritories(); }, weakestTerritory, count);
+}
+
+// Overloading the output operator
+ostream& operator<<(ostream& out, const MonteCarloPlayerStrategy&)
+{
+	return out << "Monte Carlo Player Strategy";
+}
+
+// Default constructor: 2000 rollouts of 2 rounds per turn, on every core
+MonteCarloPlayerStrategy::MonteCarloPlayerStrategy(Player* player) : MonteCarloPlayerStrategy(player, 2000, 0, 2, 0) { }
+
+// Parametrized constructor. Without a rollout budget or a time limit, the default budget is used.
+MonteCarloPlayerStrategy::MonteCarloPlayerStrategy(Player* player, int rollouts, int milliseconds, int depth, int threads)
+	: PlayerStrategy(player, MonteCarlo), rollouts(max(rollouts, 0)), milliseconds(max(milliseconds, 0)), depth(max(depth, 1)), threads(max(threads, 0))
+{
+	if (this->rollouts == 0 && this->milliseconds == 0) {
+		this->rollouts = 2000;
+	}
+}
+
+// Copy constructor
+MonteCarloPlayerStrategy::MonteCarloPlayerStrategy(const MonteCarloPlayerStrategy& hps) : PlayerStrategy(hps), rollouts(hps.rollouts),
+	milliseconds(hps.milliseconds), depth(hps.depth), threads(hps.threads) { }
+
+// Overloading the assignment operator
+MonteCarloPlayerStrategy& MonteCarloPlayerStrategy::operator=(const MonteCarloPlayerStrategy& hps)
+{
+	p = hps.p;
+	strN = hps.strN;
+	rollouts = hps.rollouts;
+	milliseconds = hps.milliseconds;
+	depth = hps.depth;
+	threads = hps.threads;
+	return *this;
+}
+
+// The Monte Carlo player picks its deploy and attack by looking ahead, then plays one card like the other computer players
+void MonteCarloPlayerStrategy::issueOrder() {
+	GameEngine* game = p->getGameEngine();
+	Map* map = game->getMap();
+	Hand* hand = p->getHand();
+	OrdersList* orders = p->getOrdersList();
+	vector<Player*>& players = game->players;
+
+	// Introduction message for each player
+	NARRATE(game) << "\nIssuing orders for player " << p->getName() << ":" << endl;
+	NARRATE(game) << "/*-------------------------------------------------------------------*/" << endl;
+
+	if (map == nullptr || p->getOwnedTerritories().empty() || (int)players.size() > Rollout::maxPlayers) {
+		NARRATE(game) << "Player " << p->getName() << " has nothing to look ahead from, skipping its turn!" << endl;
+		return;
+	}
+
+	// A reinforcement card is played first, so the search knows about the extra armies
+	bool cardPlayed = false;
+	for (int i = 0; i < hand->getSize(); i++) {
+		if (hand->getCardInHand(i)->getCardTypeName() == "Reinforcement") {
+			NARRATE(game) << "Reinforcement card selected: " << endl;
+			hand->getCardInHand(i)->play(i, 0, p, nullptr, nullptr, nullptr, game);
+			cardPlayed = true;
+			break;
+		}
+	}
+
+	// Compact copy of the board, with the deploy orders already issued this turn counted in
+	TerritoryState* state = map->getState();
+	int numTerritories = state->size();
+	int player = (int)(find(players.begin(), players.end(), p) - players.begin());
+	RolloutState root;
+	root.owner.resize(numTerritories);
+	root.armies.resize(numTerritories);
+	for (int slot = 0; slot < numTerritories; slot++) {
+		Player* owner = state->getOwner(slot);
+		root.owner[slot] = owner == nullptr ? -1 : (int)(find(players.begin(), players.end(), owner) - players.begin());
+		if (root.owner[slot] == (int)players.size()) {
+			root.owner[slot] = -1;
+		}
+		root.armies[slot] = state->getArmies(slot);
+	}
+	vector<char> truce(players.size(), 0);
+	for (int i = 0; i < (int)players.size(); i++) {
+		Player* other = players[i];
+		root.pool.push_back(other->getReinforcementPool());
+		root.active.push_back(other->getName() != "NEUTRAL" && other->getPlayerStrategy()->strN != Neutral);
+		truce[i] = find(p->cannotAttack.begin(), p->cannotAttack.end(), other) != p->cannotAttack.end();
+
+		for (Orders* o : other->getOrdersList()->ordersList) {
+			Deploy* deploy = o->getType() == OrderType::Deploy ? static_cast<Deploy*>(o) : nullptr;
+			if (deploy != nullptr && !deploy->getExecuted() && deploy->getTarget() != nullptr) {
+				int position = map->getPosition(deploy->getTarget()->getIndex());
+				if (position >= 0) root.armies[position] += deploy->getNoOfArmies();
+			}
+		}
+	}
+
+	Rollout rollout(map->getTopology());
+	vector<RolloutMove> moves;
+	rollout.candidates(root, player, truce, maxCandidates, moves);
+	RolloutMove best = moves.at(search(rollout, root, player, moves, game->getRandom()->next()));
+
+	Territory* source = map->getTerritoryAt(best.deployTo);
+	int pool = p->getReinforcementPool();
+	if (pool > 0) {
+		NARRATE(game) << "Player " << p->getName() << " has chosen territory " << source->getName() << " to deploy " << pool << " armies." << endl;
+		orders->addOrders(game->getOrderArena().create<Deploy>(p, pool, source, game));
+		p->setReinforcementPool(0);
+	}
+
+	Territory* target = nullptr;
+	if (best.attack >= 0) {
+		target = map->getTerritoryAt(best.attack);
+		int army = source->getNumberOfArmies() + pool;
+		NARRATE(game) << "Advancing from " << source->getName() << " to " << target->getName() << " " << army << " armies!" << endl;
+		Advance* advance = game->getOrderArena().create<Advance>(p, army, source, target, game);
+		for (auto it : p->cannotAttack) {
+			if (it == target->getOwner()) {
+				advance->cannotBeAttacked = true;
 			}
 		}
+		orders->addOrders(advance);
 	}
 
-	// Remove duplicates
-	for (Territory* t : attackableTerritories) {
-		attackableTerritories.erase(unique(attackableTerritories.begin(), attackableTerritories.end()), attackableTerritories.end());
+	//Clearing the cannotAttack vector for Negotiate order
+	p->cannotAttack.clear();
+
+	// One card per turn: a bomb on the strongest other enemy neighbour, an airlift to the territory deployed on, or a truce with
+	// another player than the one attacked. Blockade cards are kept, giving territories away does not help this player.
+	for (int i = 0; i < hand->getSize() && !cardPlayed; i++) {
+		Card* currentCard = hand->getCardInHand(i);
+		string cardName = currentCard->getCardTypeName();
+
+		if (cardName == "Bomb") {
+			vector<Territory*> enemies = p->toAttack();
+			for (int e = (int)enemies.size() - 1; e >= 0 && !cardPlayed; e--) {
+				if (enemies[e] != target) {
+					NARRATE(game) << "Bomb card selected:" << endl;
+					currentCard->play(i, 0, p, nullptr, nullptr, enemies[e], game);
+					cardPlayed = true;
+				}
+			}
+		}
+		else if (cardName == "Airlift") {
+			vector<Territory*> owned = p->toDefend();
+			Territory* from = owned.at(0) != source ? owned.at(0) : (owned.size() > 1 ? owned.at(1) : nullptr);
+			if (from != nullptr && from->getNumberOfArmies() > 0) {
+				NARRATE(game) << "Airlift card selected:" << endl;
+				currentCard->play(i, from->getNumberOfArmies(), p, nullptr, from, source, game);
+				cardPlayed = true;
+			}
+		}
+		else if (cardName == "Diplomacy") {
+			for (int o = 0; o < (int)players.size() && !cardPlayed; o++) {
+				if (o != player && root.active[o] && (target == nullptr || players[o] != target->getOwner())) {
+					NARRATE(game) << "Diplomacy card selected:" << endl;
+					currentCard->play(i, 0, p, players[o], nullptr, nullptr, game);
+					cardPlayed = true;
+				}
+			}
+		}
 	}
-	sort(attackableTerritories.begin(), attackableTerritories.end(), weakestTerritory);
-	return attackableTerritories;
 }
 
-// toDefend() that returns a sorted vector of territories pointers. The weakest territories are first
-vector<Territory*> CheaterPlayerStrategy::toDefend() {
-	vector<Territory*> OwnedTerritories = p->getOwnedTerritories();
-	sort(OwnedTerritories.begin(), OwnedTerritories.end(), weakestTerritory);
-	return OwnedTerritories;
+int MonteCarloPlayerStrategy::search(const Rollout& rollout, const RolloutState& root, int player, const vector<RolloutMove>& moves, uint64_t seed) {
+	int numMoves = (int)moves.size();
+	int budget = rollouts > 0 ? rollouts : INT_MAX;
+	int numThreads = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+	// A thread is not worth starting for a handful of rollouts
+	if (rollouts > 0) {
+		numThreads = max(1, min(numThreads, rollouts / 256));
+	}
+
+	auto start = chrono::steady_clock::now();
+	auto deadline = start + chrono::milliseconds(milliseconds);
+	atomic<int> nextRollout(0);
+	atomic<bool> outOfTime(false);
+	vector<double> totals(numMoves, 0);
+	vector<int> counts(numMoves, 0);
+	mutex resultsMutex;
+
+	/* Rollout i plays move i % numMoves with its own generator seeded from 'seed' and i, so which thread plays it does not
+	matter. Each thread adds up its own results and merges them once at the end. */
+	auto worker = [&]() {
+		vector<double> threadTotals(numMoves, 0);
+		vector<int> threadCounts(numMoves, 0);
+		RolloutState state;
+
+		for (int i = nextRollout++; i < budget && !outOfTime.load(memory_order_relaxed); i = nextRollout++) {
+			if (milliseconds > 0 && i % 16 == 0 && chrono::steady_clock::now() >= deadline) {
+				outOfTime = true;
+				break;
+			}
+			int m = i % numMoves;
+			Random rng(seed + (uint64_t)i);
+			state = root;
+			threadTotals[m] += rollout.play(state, player, moves[m], depth, rng);
+			threadCounts[m]++;
+		}
+
+		lock_guard<mutex> lock(resultsMutex);
+		for (int m = 0; m < numMoves; m++) {
+			totals[m] += threadTotals[m];
+			counts[m] += threadCounts[m];
+		}
+	};
+
+	vector<thread> pool;
+	for (int i = 1; i < numThreads; i++) {
+		pool.emplace_back(worker);
+	}
+	worker(); // The calling thread plays rollouts too
+	for (thread& t : pool) {
+		t.join();
+	}
+
+	int best = 0;
+	double bestScore = -1;
+	for (int m = 0; m < numMoves; m++) {
+		rolloutsPlayed += counts[m];
+		if (counts[m] > 0 && totals[m] / counts[m] > bestScore) {
+			bestScore = totals[m] / counts[m];
+			best = m;
+		}
+	}
+	secondsSearching += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	NARRATE(p->getGameEngine()) << "Player " << p->getName() << " expects to hold " << (int)(bestScore * 100) << "% of the map after " << depth << " round(s)." << endl;
+	return best;
+}
+
+// toAttack() method for the MonteCarloPlayerStrategy. It returns every enemy territory next to the player's, weakest first
+const vector<Territory*>& MonteCarloPlayerStrategy::toAttack(size_t count) {
+	return attackable(weakestTerritory, count);
+}
+
+// toDefend() method for the MonteCarloPlayerStrategy. It returns the player's territories, strongest first
+const vector<Territory*>& MonteCarloPlayerStrategy::toDefend(size_t count) {
+	return defending.get(gameMap(), [this]() { return p->getOwnedTerritories(); }, strongestTerritory, count);
+}
+
+long long MonteCarloPlayerStrategy::getRolloutsPlayed()
+{
+	return rolloutsPlayed;
+}
+
+double MonteCarloPlayerStrategy::getRolloutRate()
+{
+	return secondsSearching > 0 ? rolloutsPlayed / secondsSearching : 0;
 }
 
 // Comparator for weakest territory
 bool weakestTerritory(Territory* territory1, Territory* territory2)
 {
-	return (territory1->getNumberOfArmies() < territory2->getNumberOfArmies());
+	int armies1 = territory1->getNumberOfArmies();
+	int armies2 = territory2->getNumberOfArmies();
+	return armies1 != armies2 ? armies1 < armies2 : territory1->getIndex() < territory2->getIndex();
 }
 
 // Comparator for strongest territory
 bool strongestTerritory(Territory* territory1, Territory* territory2)
 {
-	return (territory1->getNumberOfArmies() > territory2->getNumberOfArmies());
+	int armies1 = territory1->getNumberOfArmies();
+	int armies2 = territory2->getNumberOfArmies();
+	return armies1 != armies2 ? armies1 > armies2 : territory1->getIndex() < territory2->getIndex();
 }
\ No newline at end of file
@@ -3,9 +3,47 @@
 #include "Player.h" // Include player to overload its methods
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 
 // Forward declaration
 class Territory;
+class TerritoryState;
+class Map;
+class Rollout;
+struct RolloutState;
+struct RolloutMove;
+
+// Order of two territories for a TerritoryOrdering, true if the first one comes first
+typedef bool (*TerritoryOrder)(Territory*, Territory*);
+
+/* A strategy's list of territories in its order, kept from one call to the next until the map's state changes (see
+TerritoryState::getEpoch). Only as much of the list as was asked for is sorted: the first 'count' territories are in order,
+and asking for more later only sorts the rest. The order must be total (no ties) so that sorting part of the list and
+then the rest gives the same list as sorting it all at once. */
+class TerritoryOrdering
+{
+public:
+	// The list, with its first 'count' territories in order. 'source' builds the list, and is only called when the map has
+	// changed since it was last built. A null 'order' keeps the list in the order 'source' built it.
+	template<class Source>
+	const vector<Territory*>& get(Map* map, Source source, TerritoryOrder order, size_t count) {
+		if (isStale(map)) {
+			rebuild(map, source());
+		}
+		sortFirst(order, count);
+		return territories;
+	}
+
+private:
+	vector<Territory*> territories;
+	const TerritoryState* state = nullptr;
+	uint64_t epoch = 0;
+	size_t sorted = 0; // The first 'sorted' territories are in order
+
+	bool isStale(Map* map);
+	void rebuild(Map* map, vector<Territory*> list);
+	void sortFirst(TerritoryOrder order, size_t count);
+};
 
 // Abstract parent class, inherited by all children
 class PlayerStrategy {
@@ -13,17 +51,27 @@ private:
 	friend ostream& operator<<(ostream& out, const PlayerStrategy&); // Stream insertion operator
 protected:
 	Player* p;	
+	// toDefend() and toAttack() lists, cached for as long as the map does not change
+	TerritoryOrdering defending;
+	TerritoryOrdering attacking;
+	// Map of the player's game, nullptr if there is none
+	Map* gameMap();
+	// The player's frontier (the territories it could attack) as a toAttack() list in the given order, see TerritoryOrdering
+	const vector<Territory*>& attackable(TerritoryOrder order, size_t count);
 public:
-	enum strategyName { Human, Aggressive, Benevolent, Neutral, Cheater};
+	enum strategyName { Human, Aggressive, Benevolent, Neutral, Cheater, MonteCarlo};
 	strategyName strN;
 	PlayerStrategy(Player*, strategyName); // Default Constructor
 	PlayerStrategy(const PlayerStrategy&); // Copy Constructor
+	virtual ~PlayerStrategy(); // Destructor, virtual since players delete their strategy through this class
 	PlayerStrategy& operator =(const PlayerStrategy&); // Assignment operator
 	Player* getPlayer();
 	void setPlayer(Player*);
 	virtual void issueOrder() = 0;
-	virtual vector<Territory*> toAttack() = 0;
-	virtual vector<Territory*> toDefend() = 0;
+	// Territories to attack and to defend, in the strategy's order. Only the first 'count' of them need to be in order
+	// (see TerritoryOrdering); use Player::toAttack and Player::toDefend.
+	virtual const vector<Territory*>& toAttack(size_t count) = 0;
+	virtual const vector<Territory*>& toDefend(size_t count) = 0;
 };
 
 // Human player: requires user interactions to make decisions.
@@ -35,8 +83,8 @@ public:
 	HumanPlayerStrategy(const HumanPlayerStrategy&);
 	HumanPlayerStrategy& operator =(const HumanPlayerStrategy&);
 	virtual void issueOrder();
-	virtual vector<Territory*> toAttack();
-	virtual vector<Territory*> toDefend();
+	virtual const vector<Territory*>& toAttack(size_t count);
+	virtual const vector<Territory*>& toDefend(size_t count);
 };
 
 // Aggressive player : computer player that focuses on attack
@@ -48,8 +96,8 @@ public:
 	AggressivePlayerStrategy(const AggressivePlayerStrategy&);
 	AggressivePlayerStrategy& operator =(const AggressivePlayerStrategy&);
 	virtual void issueOrder();
-	virtual vector<Territory*> toAttack();
-	virtual vector<Territory*> toDefend();
+	virtual const vector<Territory*>& toAttack(size_t count);
+	virtual const vector<Territory*>& toDefend(size_t count);
 };
 
 // Benevolent player: computer player that focuses on protecting its weak countries
@@ -61,8 +109,8 @@ public:
 	BenevolentPlayerStrategy(const BenevolentPlayerStrategy&);
 	BenevolentPlayerStrategy& operator =(const BenevolentPlayerStrategy&);
 	virtual void issueOrder();
-	virtual vector<Territory*> toAttack();
-	virtual vector<Territory*> toDefend();
+	virtual const vector<Territory*>& toAttack(size_t count);
+	virtual const vector<Territory*>& toDefend(size_t count);
 };
 
 /* Neutral player: computer player that never issues any order. If a Neutral player is attacked, it becomes an
@@ -75,8 +123,8 @@ public:
 	NeutralPlayerStrategy(const NeutralPlayerStrategy&);
 	NeutralPlayerStrategy& operator =(const NeutralPlayerStrategy&);
 	virtual void issueOrder();
-	virtual vector<Territory*> toAttack();
-	virtual vector<Territory*> toDefend();
+	virtual const vector<Territory*>& toAttack(size_t count);
+	virtual const vector<Territory*>& toDefend(size_t count);
 };
 
 // Cheater player: computer player that automatically conquers all territories that are adjacent to its own territories
@@ -88,9 +136,40 @@ public:
 	CheaterPlayerStrategy(const CheaterPlayerStrategy&);
 	CheaterPlayerStrategy& operator =(const CheaterPlayerStrategy&);
 	virtual void issueOrder();
-	virtual vector<Territory*> toAttack();
-	virtual vector<Territory*> toDefend();
+	virtual const vector<Territory*>& toAttack(size_t count);
+	virtual const vector<Territory*>& toDefend(size_t count);
+};
+
+/* Monte Carlo player: computer player that looks ahead. Every turn it lists candidate order sets (deploy its whole pool on
+one frontier territory, then attack one of its neighbours with everything there, or hold), plays many quick random games
+from each one on a compact copy of the board (see Rollout), and issues the candidate with the best average outcome.
+The rollouts are shared out between threads; with a rollout budget and no time limit, the same game always makes the same
+choices whatever the number of threads. */
+class MonteCarloPlayerStrategy : public PlayerStrategy {
+private:
+	friend ostream& operator<<(ostream& out, const MonteCarloPlayerStrategy&);
+	int rollouts; // Rollouts per turn, 0 for as many as the time limit allows
+	int milliseconds; // Time limit per turn, 0 for none
+	int depth; // Rounds played by each rollout
+	int threads; // Threads playing the rollouts, 0 for one per core
+	long long rolloutsPlayed = 0;
+	double secondsSearching = 0;
+	// Plays the rollouts and returns the position of the best move in 'moves'
+	int search(const Rollout& rollout, const RolloutState& root, int player, const vector<RolloutMove>& moves, uint64_t seed);
+public:
+	// Most candidate moves evaluated per turn
+	static const int maxCandidates = 24;
+	MonteCarloPlayerStrategy(Player*);
+	MonteCarloPlayerStrategy(Player*, int rollouts, int milliseconds, int depth, int threads);
+	MonteCarloPlayerStrategy(const MonteCarloPlayerStrategy&);
+	MonteCarloPlayerStrategy& operator =(const MonteCarloPlayerStrategy&);
+	virtual void issueOrder();
+	virtual const vector<Territory*>& toAttack(size_t count);
+	virtual const vector<Territory*>& toDefend(size_t count);
+	// Rollouts played so far, and how many of them per second of searching
+	long long getRolloutsPlayed();
+	double getRolloutRate();
 };
 
-bool weakestTerritory(Territory*, Territory*); // Compares two territories and returns a boolean signifiying the weakest one
-bool strongestTerritory(Territory*, Territory*); // Compares two territories and returns a boolean signifiying  the strongest one
\ No newline at end of file
+bool weakestTerritory(Territory*, Territory*); // Compares two territories and returns a boolean signifiying the weakest one (ties by index)
+bool strongestTerritory(Territory*, Territory*); // Compares two territories and returns a boolean signifiying  the strongest one (ties by index)
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "Rollout.h"
+#include "../Orders/Battle.h"
+#include <algorithm>
+
+Rollout::Rollout(shared_ptr<const MapTopology> topology) : topology(topology), adjacencyOffsets(topology->getAdjacencyOffsets()),
+	adjacency(topology->getAdjacency()), continentOffsets(topology->getContinentOffsets()), continentMembers(topology->getContinentMembers()),
+	continentArmies(topology->getContinentArmies()) {}
+
+double Rollout::play(RolloutState& state, int player, RolloutMove move, int rounds, Random& rng) const {
+	playRound(state, player, move, rng);
+	for (int round = 1; round < rounds; round++) {
+		reinforce(state);
+		playRound(state, -1, RolloutMove(), rng);
+	}
+	return score(state, player);
+}
+
+double Rollout::score(const RolloutState& state, int player) const {
+	int numTerritories = (int)state.owner.size();
+	int owned = 0;
+	long long armies = 0;
+	long long totalArmies = 0;
+
+	for (int t = 0; t < numTerritories; t++) {
+		totalArmies += state.armies[t];
+		if (state.owner[t] == player) {
+			owned++;
+			armies += state.armies[t];
+		}
+	}
+
+	if (owned == 0) {
+		return 0;
+	}
+	return 0.5 * owned / numTerritories + (totalArmies > 0 ? 0.5 * armies / totalArmies : 0.5);
+}
+
+void Rollout::candidates(const RolloutState& state, int player, const vector<char>& truce, int maxMoves, vector<RolloutMove>& moves) const {
+	int numTerritories = (int)state.owner.size();
+	int pool = state.pool[player];
+	vector<pair<double, RolloutMove>> ranked;
+	int strongest = -1;
+
+	for (int t = 0; t < numTerritories; t++) {
+		if (state.owner[t] != player) {
+			continue;
+		}
+		if (strongest == -1 || state.armies[t] > state.armies[strongest]) {
+			strongest = t;
+		}
+
+		bool frontier = false;
+		for (int e = adjacencyOffsets[t]; e < adjacencyOffsets[t + 1]; e++) {
+			int neighbour = adjacency[e];
+			int enemy = state.owner[neighbour];
+
+			if (enemy != player && (enemy < 0 || !truce[enemy])) {
+				frontier = true;
+				// Odds of the attack: armies there after deploying against armies defending
+				ranked.push_back({ (double)(state.armies[t] + pool) / (state.armies[neighbour] + 1), { t, neighbour } });
+			}
+		}
+		// Holding is ranked like an even attack, so a frontier territory's hold survives the cut before its long shots do
+		if (frontier) {
+			ranked.push_back({ 1.0, { t, -1 } });
+		}
+	}
+
+	moves.clear();
+	if (ranked.empty()) {
+		if (strongest != -1) {
+			moves.push_back({ strongest, -1 });
+		}
+		return;
+	}
+
+	stable_sort(ranked.begin(), ranked.end(), [](const pair<double, RolloutMove>& a, const pair<double, RolloutMove>& b) { return a.first > b.first; });
+	for (int i = 0; i < (int)ranked.size() && i < maxMoves; i++) {
+		moves.push_back(ranked[i].second);
+	}
+}
+
+void Rollout::reinforce(RolloutState& state) const {
+	int numPlayers = (int)state.pool.size();
+	int counts[maxPlayers] = {};
+	int bonus[maxPlayers] = {};
+
+	for (int o : state.owner) {
+		if (o >= 0) {
+			counts[o]++;
+		}
+	}
+
+	// A continent's bonus goes to whoever owns every one of its territories
+	int numContinents = (int)continentArmies.size();
+	for (int c = 0; c < numContinents; c++) {
+		if (continentOffsets[c] == continentOffsets[c + 1]) {
+			continue;
+		}
+		int o = state.owner[continentMembers[continentOffsets[c]]];
+		int m = continentOffsets[c] + 1;
+		while (m < continentOffsets[c + 1] && state.owner[continentMembers[m]] == o) {
+			m++;
+		}
+		if (o >= 0 && m == continentOffsets[c + 1]) {
+			bonus[o] += continentArmies[c];
+		}
+	}
+
+	for (int p = 0; p < numPlayers; p++) {
+		if (counts[p] > 0) {
+			state.pool[p] = max(state.pool[p] + counts[p] / 3 + bonus[p], 3);
+		}
+	}
+}
+
+void Rollout::playRound(RolloutState& state, int player, RolloutMove move, Random& rng) const {
+	int numPlayers = (int)state.pool.size();
+	int numTerritories = (int)state.owner.size();
+	int source[maxPlayers];
+	int frontierSeen[maxPlayers] = {};
+	fill(source, source + numPlayers, -1);
+
+	// Each player without a fixed move picks one of its frontier territories uniformly, in a single pass over the map
+	for (int t = 0; t < numTerritories; t++) {
+		int o = state.owner[t];
+		if (o < 0 || o == player || !state.active[o]) {
+			continue;
+		}
+
+		for (int e = adjacencyOffsets[t]; e < adjacencyOffsets[t + 1]; e++) {
+			if (state.owner[adjacency[e]] != o) {
+				if (rng.nextInt(++frontierSeen[o]) == 0) {
+					source[o] = t;
+				}
+				break;
+			}
+		}
+	}
+	if (player >= 0 && move.deployTo >= 0 && state.owner[move.deployTo] == player) {
+		source[player] = move.deployTo;
+	}
+
+	// Deploy orders are all executed before any other order
+	for (int p = 0; p < numPlayers; p++) {
+		if (source[p] >= 0 && state.active[p]) {
+			state.armies[source[p]] += state.pool[p];
+			state.pool[p] = 0;
+		}
+	}
+
+	for (int p = 0; p < numPlayers; p++) {
+		int from = source[p];
+		if (from < 0 || !state.active[p] || state.owner[from] != p) {
+			continue;
+		}
+
+		if (p == player) {
+			if (move.attack >= 0) {
+				advance(state, from, move.attack, rng);
+			}
+		}
+		else {
+			int target = weakestEnemy(state, from);
+			if (target >= 0 && state.armies[from] > state.armies[target]) {
+				advance(state, from, target, rng);
+			}
+		}
+	}
+}
+
+int Rollout::weakestEnemy(const RolloutState& state, int territory) const {
+	int o = state.owner[territory];
+	int weakest = -1;
+
+	for (int e = adjacencyOffsets[territory]; e < adjacencyOffsets[territory + 1]; e++) {
+		int neighbour = adjacency[e];
+		if (state.owner[neighbour] != o && (weakest == -1 || state.armies[neighbour] < state.armies[weakest])) {
+			weakest = neighbour;
+		}
+	}
+	return weakest;
+}
+
+void Rollout::advance(RolloutState& state, int source, int target, Random& rng) const {
+	int attacker = state.owner[source];
+	int armies = state.armies[source];
+	state.armies[source] = 0;
+
+	if (state.owner[target] == attacker) {
+		state.armies[target] += armies;
+		return;
+	}
+
+	// As in the Advance order, attackers that lose the battle are all gone and the defenders keep their armies
+	BattleResult battle = Battle::resolve(armies, state.armies[target], rng);
+	if (battle.captured) {
+		state.owner[target] = attacker;
+		state.armies[target] = battle.survivors;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "../Map/Map.h"
+#include "../Game Engine/Random.h"
+
+using namespace std;
+
+// Compact copy of a game for looking ahead: plain arrays indexed by territory position and by player position, so copying one is a few memcpys
+struct RolloutState {
+	vector<int> owner; // Player that owns each territory, -1 if nobody does
+	vector<int> armies; // Armies on each territory
+	vector<int> pool; // Reinforcement pool of each player
+	vector<char> active; // Players that issue orders (the neutral player does not)
+};
+
+// Order set of one player for a round: deploy the whole pool on 'deployTo', then advance all of its armies to 'attack' (-1 to hold)
+struct RolloutMove {
+	int deployTo = -1;
+	int attack = -1;
+};
+
+/* Plays quick random games on a RolloutState, for strategies that look ahead (see MonteCarloPlayerStrategy).
+
+A rollout follows the phases of a round on the arrays alone: every active player deploys their pool on one territory and
+advances everything on it against one enemy neighbour, in turn order, battles being resolved with Battle::resolve. Players
+without a fixed move pick a random frontier territory and attack its weakest enemy neighbour when they outnumber it. Cards,
+truces and moves between a player's own territories are left out: a rollout is a cheap estimate, not a replay of the rules.
+
+A Rollout only reads the map's topology, which never changes, so one Rollout can be used from several threads at once as
+long as each thread has its own RolloutState and Random. */
+class Rollout
+{
+public:
+	explicit Rollout(shared_ptr<const MapTopology> topology);
+
+	// Most players a RolloutState can have (a game has at most 6 players and the neutral player)
+	static const int maxPlayers = 16;
+
+	// Plays 'move' for 'player' and the default policy for everyone else this round, then 'rounds' - 1 more rounds of the default
+	// policy for everyone (reinforcements first), and returns the player's score at the end
+	double play(RolloutState& state, int player, RolloutMove move, int rounds, Random& rng) const;
+	// Average of the player's share of the territories and of the armies on the map, 0 to 1
+	double score(const RolloutState& state, int player) const;
+	// Candidate moves for a player: every frontier territory, holding or attacking each enemy neighbour that is not in 'truce',
+	// best odds first, at most 'maxMoves' of them. A player without a frontier only gets to deploy on its strongest territory.
+	void candidates(const RolloutState& state, int player, const vector<char>& truce, int maxMoves, vector<RolloutMove>& moves) const;
+
+private:
+	shared_ptr<const MapTopology> topology;
+	const vector<int>& adjacencyOffsets;
+	const vector<int>& adjacency;
+	const vector<int>& continentOffsets;
+	const vector<int>& continentMembers;
+	const vector<int>& continentArmies;
+
+	// Adds the armies each player gets at the start of a round to their pool
+	void reinforce(RolloutState& state) const;
+	// One round of orders, with 'player' playing 'move' (no player has a fixed move if 'player' is -1)
+	void playRound(RolloutState& state, int player, RolloutMove move, Random& rng) const;
+	// The default policy's weakest enemy neighbour of a territory, -1 if it has none
+	int weakestEnemy(const RolloutState& state, int territory) const;
+	// Advances every army on 'source' to 'target', fighting if the target belongs to someone else
+	void advance(RolloutState& state, int source, int target, Random& rng) const;
+};
@@ -10,9 +10,6 @@ players make decisions automatically, which are both implemented using the strat
 int main()
 {
 
-    // Random initializer
-    srand((int)time(nullptr));
-
     GameEngine* game = new GameEngine();
 
     // Initializing states
@@ -50,6 +47,9 @@ int main()
     // Create a map from file and assign to this game instance
     string fileName = "test.map";
     Map* map = MapLoader::createMapfromFile(fileName);
+    if (map == NULL) {
+        return 1;
+    }
     map->validate();
     game->setMap(map);
 